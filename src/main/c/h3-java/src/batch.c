@@ -0,0 +1,199 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "batch.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "parallel.h"
+
+/**
+ * Number of inputs below which a kernel runs on the calling thread only, as
+ * starting threads would take longer than the work.
+ */
+#define BATCH_MIN_PARALLEL 4096
+
+static int threadsFor(size_t numItems, int numThreads) {
+    return numItems < BATCH_MIN_PARALLEL ? 1 : numThreads;
+}
+
+typedef struct {
+    const GeoCoord *coords;
+    int res;
+    H3Index *out;
+} GeoToH3Context;
+
+static int geoToH3Range(void *context, size_t begin, size_t end) {
+    GeoToH3Context *c = context;
+    for (size_t i = begin; i < end; i++) {
+        c->out[i] = geoToH3(&c->coords[i], c->res);
+    }
+    return 0;
+}
+
+void geoToH3Batch(const GeoCoord *coords, size_t numCoords, int res,
+                  int numThreads, H3Index *out) {
+    GeoToH3Context context = {coords, res, out};
+    parallelFor(numCoords, threadsFor(numCoords, numThreads), geoToH3Range,
+                &context);
+}
+
+typedef struct {
+    const H3Index *cells;
+    GeoCoord *out;
+} H3ToGeoContext;
+
+static int h3ToGeoRange(void *context, size_t begin, size_t end) {
+    H3ToGeoContext *c = context;
+    for (size_t i = begin; i < end; i++) {
+        if (h3IsValid(c->cells[i])) {
+            h3ToGeo(c->cells[i], &c->out[i]);
+        } else {
+            c->out[i].lat = c->out[i].lon = NAN;
+        }
+    }
+    return 0;
+}
+
+void h3ToGeoBatch(const H3Index *cells, size_t numCells, int numThreads,
+                  GeoCoord *out) {
+    H3ToGeoContext context = {cells, out};
+    parallelFor(numCells, threadsFor(numCells, numThreads), h3ToGeoRange,
+                &context);
+}
+
+typedef struct {
+    const H3Index *cells;
+    int *offsets;
+    GeoCoord *out;
+} BoundaryContext;
+
+/**
+ * Writes the boundary of each cell to its own MAX_CELL_BNDRY_VERTS slots of
+ * the output, and its number of vertices to its offset.
+ */
+static int h3ToGeoBoundaryRange(void *context, size_t begin, size_t end) {
+    BoundaryContext *c = context;
+    for (size_t i = begin; i < end; i++) {
+        c->offsets[i] = 0;
+        if (!h3IsValid(c->cells[i])) {
+            continue;
+        }
+        GeoBoundary boundary;
+        h3ToGeoBoundary(c->cells[i], &boundary);
+        memcpy(&c->out[i * MAX_CELL_BNDRY_VERTS], boundary.verts,
+               boundary.numVerts * sizeof(GeoCoord));
+        c->offsets[i] = boundary.numVerts;
+    }
+    return 0;
+}
+
+void h3ToGeoBoundaryBatch(const H3Index *cells, size_t numCells,
+                          int numThreads, int *offsets, GeoCoord *out) {
+    BoundaryContext context = {cells, offsets, out};
+    parallelFor(numCells, threadsFor(numCells, numThreads),
+                h3ToGeoBoundaryRange, &context);
+
+    // Close the gaps between boundaries. Each moves towards the start, so
+    // none is overwritten before it is moved.
+    int numVerts = 0;
+    for (size_t i = 0; i < numCells; i++) {
+        int cellVerts = offsets[i];
+        offsets[i] = numVerts;
+        if ((size_t)numVerts != i * MAX_CELL_BNDRY_VERTS) {
+            memmove(&out[numVerts], &out[i * MAX_CELL_BNDRY_VERTS],
+                    cellVerts * sizeof(GeoCoord));
+        }
+        numVerts += cellVerts;
+    }
+    offsets[numCells] = numVerts;
+}
+
+typedef struct {
+    const H3Index *cells;
+    BatchUnit unit;
+    double *out;
+} CellAreaContext;
+
+static int cellAreaRange(void *context, size_t begin, size_t end) {
+    CellAreaContext *c = context;
+    for (size_t i = begin; i < end; i++) {
+        H3Index cell = c->cells[i];
+        if (!h3IsValid(cell)) {
+            c->out[i] = 0;
+        } else if (c->unit == BATCH_UNIT_KM) {
+            c->out[i] = cellAreaKm2(cell);
+        } else if (c->unit == BATCH_UNIT_M) {
+            c->out[i] = cellAreaM2(cell);
+        } else {
+            c->out[i] = cellAreaRads2(cell);
+        }
+    }
+    return 0;
+}
+
+void cellAreaBatch(const H3Index *cells, size_t numCells, BatchUnit unit,
+                   int numThreads, double *out) {
+    CellAreaContext context = {cells, unit, out};
+    parallelFor(numCells, threadsFor(numCells, numThreads), cellAreaRange,
+                &context);
+}
+
+typedef struct {
+    const H3Index *cells;
+    int res;
+    H3Index *out;
+} ParentContext;
+
+static int h3ToParentRange(void *context, size_t begin, size_t end) {
+    ParentContext *c = context;
+    for (size_t i = begin; i < end; i++) {
+        H3Index cell = c->cells[i];
+        c->out[i] = h3IsValid(cell) && h3GetResolution(cell) >= c->res
+                        ? h3ToParent(cell, c->res)
+                        : 0;
+    }
+    return 0;
+}
+
+void h3ToParentBatch(const H3Index *cells, size_t numCells, int res,
+                     int numThreads, H3Index *out) {
+    ParentContext context = {cells, res, out};
+    parallelFor(numCells, threadsFor(numCells, numThreads), h3ToParentRange,
+                &context);
+}
+
+typedef struct {
+    const H3Index *origins;
+    const H3Index *destinations;
+    int *out;
+} DistanceContext;
+
+static int h3DistanceRange(void *context, size_t begin, size_t end) {
+    DistanceContext *c = context;
+    for (size_t i = begin; i < end; i++) {
+        c->out[i] = h3Distance(c->origins[i], c->destinations[i]);
+    }
+    return 0;
+}
+
+void h3DistanceBatch(const H3Index *origins, const H3Index *destinations,
+                     size_t numPairs, int numThreads, int *out) {
+    DistanceContext context = {origins, destinations, out};
+    parallelFor(numPairs, threadsFor(numPairs, numThreads), h3DistanceRange,
+                &context);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stddef.h>
+
+#include "h3api.h"
+
+/**
+ * Units of areas and lengths, in the order of AreaUnit and LengthUnit.
+ */
+typedef enum {
+    /** Radians, or square radians */
+    BATCH_UNIT_RADS = 0,
+    /** Kilometers, or square kilometers */
+    BATCH_UNIT_KM = 1,
+    /** Meters, or square meters */
+    BATCH_UNIT_M = 2
+} BatchUnit;
+
+/**
+ * The kernels below call the H3 function on each input, using up to
+ * `numThreads` threads once there are enough inputs for threads to be worth
+ * starting.
+ */
+
+/**
+ * Finds the cell of each coordinate. An invalid coordinate has the invalid
+ * index.
+ */
+void geoToH3Batch(const GeoCoord *coords, size_t numCoords, int res,
+                  int numThreads, H3Index *out);
+
+/**
+ * Finds the center of each cell. The center of an invalid cell is NaN.
+ */
+void h3ToGeoBatch(const H3Index *cells, size_t numCells, int numThreads,
+                  GeoCoord *out);
+
+/**
+ * Finds the boundary of each cell, and writes the vertices to `out`, one cell
+ * after another. `out` must have room for MAX_CELL_BNDRY_VERTS vertices per
+ * cell. `offsets` must have room for numCells + 1 entries, and is filled with
+ * the first vertex of each cell, followed by the number of vertices written.
+ * An invalid cell has no vertices.
+ */
+void h3ToGeoBoundaryBatch(const H3Index *cells, size_t numCells,
+                          int numThreads, int *offsets, GeoCoord *out);
+
+/**
+ * Finds the area of each cell. The area of an invalid cell is 0.
+ */
+void cellAreaBatch(const H3Index *cells, size_t numCells, BatchUnit unit,
+                   int numThreads, double *out);
+
+/**
+ * Finds the parent of each cell at `res`. The parent of an invalid cell, or
+ * of a cell coarser than `res`, is the invalid index.
+ */
+void h3ToParentBatch(const H3Index *cells, size_t numCells, int res,
+                     int numThreads, H3Index *out);
+
+/**
+ * Finds the grid distance from each origin to the destination at the same
+ * position, or -1 where it is not defined.
+ */
+void h3DistanceBatch(const H3Index *origins, const H3Index *destinations,
+                     size_t numPairs, int numThreads, int *out);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "cellBBox.h"
+
+#include <math.h>
+
+#include "geoConstants.h"
+#include "vec3.h"
+
+/**
+ * Constrains a longitude to [-pi, pi].
+ */
+static double constrainLng(double lng) {
+    while (lng > GEO_PI) {
+        lng -= GEO_2PI;
+    }
+    while (lng < -GEO_PI) {
+        lng += GEO_2PI;
+    }
+    return lng;
+}
+
+/**
+ * Extends the latitudes of the box to include the points of the great circle
+ * arc from a to b farthest north and south, if they are between a and b.
+ */
+static void addArcLatitudes(Vec3 a, Vec3 b, LatLngBox *box) {
+    Vec3 n = cross(a, b);
+    double nn = dot(n, n);
+    if (nn == 0) {
+        return;
+    }
+    // The northernmost point of the great circle, that is, the unit z vector
+    // projected onto the plane of the circle.
+    Vec3 top = {-n.z * n.x / nn, -n.z * n.y / nn, 1 - n.z * n.z / nn};
+    double length = sqrt(dot(top, top));
+    if (length == 0) {
+        // The arc is on the equator
+        return;
+    }
+    double topLat = asin(fmin(1, top.z / length));
+    if (dot(cross(a, top), n) > 0 && dot(cross(top, b), n) > 0 &&
+        topLat > box->north) {
+        box->north = topLat;
+    }
+    // The southernmost point is opposite the northernmost
+    Vec3 bottom = {-top.x, -top.y, -top.z};
+    if (dot(cross(a, bottom), n) > 0 && dot(cross(bottom, b), n) > 0 &&
+        -topLat < box->south) {
+        box->south = -topLat;
+    }
+}
+
+void cellToBBox(H3Index cell, LatLngBox *box) {
+    if (!h3IsValid(cell)) {
+        box->north = box->south = box->east = box->west = NAN;
+        return;
+    }
+
+    GeoBoundary boundary;
+    h3ToGeoBoundary(cell, &boundary);
+
+    // Longitudes are unwrapped relative to the first vertex, so the range
+    // found is continuous even across the antimeridian.
+    double lng = boundary.verts[0].lon;
+    double minLng = lng;
+    double maxLng = lng;
+    double latSum = 0;
+    box->north = box->south = boundary.verts[0].lat;
+    for (int i = 0; i < boundary.numVerts; i++) {
+        const GeoCoord *from = &boundary.verts[i];
+        const GeoCoord *to = &boundary.verts[(i + 1) % boundary.numVerts];
+        latSum += from->lat;
+        box->north = fmax(box->north, from->lat);
+        box->south = fmin(box->south, from->lat);
+        Vec3 a = geoToVec3(from);
+        Vec3 b = geoToVec3(to);
+        addArcLatitudes(a, b, box);
+
+        // The longitude of a great circle arc not through a pole changes
+        // monotonically, so the vertices bound it.
+        lng += constrainLng(to->lon - from->lon);
+        minLng = fmin(minLng, lng);
+        maxLng = fmax(maxLng, lng);
+    }
+
+    // Going around a pole, the longitude changes by a full turn.
+    if (fabs(lng - boundary.verts[0].lon) > GEO_PI) {
+        if (latSum > 0) {
+            box->north = GEO_PI_2;
+        } else {
+            box->south = -GEO_PI_2;
+        }
+        box->west = -GEO_PI;
+        box->east = GEO_PI;
+        return;
+    }
+    box->west = constrainLng(minLng);
+    box->east = constrainLng(maxLng);
+}
+
+void cellsToBBoxes(const H3Index *cells, size_t numCells, double *out) {
+    for (size_t i = 0; i < numCells; i++) {
+        LatLngBox box;
+        cellToBBox(cells[i], &box);
+        out[i * 4] = box.south;
+        out[i * 4 + 1] = box.west;
+        out[i * 4 + 2] = box.north;
+        out[i * 4 + 3] = box.east;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CELLBBOX_H
+#define CELLBBOX_H
+
+#include <stddef.h>
+
+#include "h3api.h"
+#include "polyfill.h"
+
+/**
+ * Finds the latitude and longitude bounding box of a cell, in radians.
+ *
+ * The edges of the cell are great circle arcs, so the box includes the
+ * latitudes an edge reaches between its vertices. If the cell crosses the
+ * antimeridian, west is greater than east. If the cell contains a pole, the
+ * box extends to that pole and covers all longitudes.
+ *
+ * The box of an invalid cell is all NaN.
+ */
+void cellToBBox(H3Index cell, LatLngBox *box);
+
+/**
+ * Finds the bounding box of each cell, and writes them to `out` as south,
+ * west, north, east, in radians, four per cell.
+ */
+void cellsToBBoxes(const H3Index *cells, size_t numCells, double *out);
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cellSet.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Minimum number of slots in the hash table.
+ */
+#define CELL_SET_MIN_CAPACITY 16
+
+/**
+ * Mixes the bits of the index, as the low bits of nearby cells are mostly the
+ * same. This is the finalizer of MurmurHash3.
+ */
+static size_t cellHash(H3Index cell) {
+    uint64_t h = cell;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+/**
+ * Inserts into the slots, which must have room. Returns false if the cell was
+ * already present.
+ */
+static bool insertSlot(H3Index *slots, size_t capacity, H3Index cell) {
+    size_t mask = capacity - 1;
+    size_t i = cellHash(cell) & mask;
+    while (slots[i] != 0) {
+        if (slots[i] == cell) {
+            return false;
+        }
+        i = (i + 1) & mask;
+    }
+    slots[i] = cell;
+    return true;
+}
+
+int cellSetInit(CellSet *set, size_t expected) {
+    size_t capacity = CELL_SET_MIN_CAPACITY;
+    // Keep the load factor at or below one half
+    while (capacity < expected * 2) {
+        capacity <<= 1;
+    }
+
+    set->slots = calloc(capacity, sizeof(H3Index));
+    set->cells = malloc((capacity / 2) * sizeof(H3Index));
+    set->capacity = capacity;
+    set->size = 0;
+    if (set->slots == NULL || set->cells == NULL) {
+        cellSetDestroy(set);
+        return 1;
+    }
+    return 0;
+}
+
+void cellSetDestroy(CellSet *set) {
+    free(set->slots);
+    free(set->cells);
+    set->slots = NULL;
+    set->cells = NULL;
+    set->capacity = 0;
+    set->size = 0;
+}
+
+/**
+ * Doubles the capacity of the set. Returns 0 on success.
+ */
+static int grow(CellSet *set) {
+    size_t capacity = set->capacity * 2;
+    H3Index *slots = calloc(capacity, sizeof(H3Index));
+    if (slots == NULL) {
+        return 1;
+    }
+    H3Index *cells = realloc(set->cells, (capacity / 2) * sizeof(H3Index));
+    if (cells == NULL) {
+        free(slots);
+        return 1;
+    }
+    for (size_t i = 0; i < set->size; i++) {
+        insertSlot(slots, capacity, cells[i]);
+    }
+    free(set->slots);
+    set->slots = slots;
+    set->cells = cells;
+    set->capacity = capacity;
+    return 0;
+}
+
+int cellSetAdd(CellSet *set, H3Index cell) {
+    if (set->size + 1 > set->capacity / 2 && grow(set)) {
+        return -1;
+    }
+    if (!insertSlot(set->slots, set->capacity, cell)) {
+        return 0;
+    }
+    set->cells[set->size] = cell;
+    set->size++;
+    return 1;
+}
+
+bool cellSetContains(const CellSet *set, H3Index cell) {
+    if (set->capacity == 0) {
+        return false;
+    }
+    size_t mask = set->capacity - 1;
+    size_t i = cellHash(cell) & mask;
+    while (set->slots[i] != 0) {
+        if (set->slots[i] == cell) {
+            return true;
+        }
+        i = (i + 1) & mask;
+    }
+    return false;
+}
+
+static int compareCells(const void *a, const void *b) {
+    H3Index x = *(const H3Index *)a;
+    H3Index y = *(const H3Index *)b;
+    return x < y ? -1 : x > y;
+}
+
+void cellSetSort(CellSet *set) {
+    // The slots hold the members themselves, so they are not affected.
+    qsort(set->cells, set->size, sizeof(H3Index), compareCells);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLSET_H
+#define CELLSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "h3api.h"
+
+/**
+ * A growable open addressing hash set of H3 indexes. 0 is used to mark
+ * empty slots, so it cannot be a member.
+ *
+ * Members are also kept in insertion order in `cells`.
+ */
+typedef struct {
+    // Slots of the hash table, capacity is always a power of two
+    H3Index *slots;
+    size_t capacity;
+    // Members, in the order they were added
+    H3Index *cells;
+    size_t size;
+} CellSet;
+
+/**
+ * Initializes an empty set with room for at least `expected` members.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int cellSetInit(CellSet *set, size_t expected);
+
+/**
+ * Frees the memory held by the set.
+ */
+void cellSetDestroy(CellSet *set);
+
+/**
+ * Adds a cell to the set.
+ *
+ * Returns 1 if the cell was added, 0 if it was already a member, or -1 if
+ * memory could not be allocated.
+ */
+int cellSetAdd(CellSet *set, H3Index cell);
+
+/**
+ * Returns true if the cell is a member of the set.
+ */
+bool cellSetContains(const CellSet *set, H3Index cell);
+
+/**
+ * Sorts the members in `cells` in ascending order. The set is otherwise
+ * unchanged, and may still be added to.
+ */
+void cellSetSort(CellSet *set);
+
+#endif
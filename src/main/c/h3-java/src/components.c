@@ -0,0 +1,153 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "components.h"
+
+#include <stdbool.h>
+
+/**
+ * Number of cells within one grid step of a cell, including itself.
+ */
+#define NEIGHBORHOOD_SIZE 7
+
+/**
+ * Adds the cells of the input to the set, ignoring invalid cells.
+ */
+static int addCells(const H3Index *cells, size_t numCells, CellSet *set) {
+    for (size_t i = 0; i < numCells; i++) {
+        if (h3IsValid(cells[i]) && cellSetAdd(set, cells[i]) < 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Finds the cells connected to start which are inside (or outside) the
+ * region, in breadth first order, by adding them to `flood`, which must be
+ * empty.
+ *
+ * The fill stops early if it reaches more than maxSize cells or a cell in
+ * `stop`, which may be NULL. Returns true in `stopped` if so.
+ */
+static int floodFill(H3Index start, const CellSet *region, bool inside,
+                     size_t maxSize, const CellSet *stop, CellSet *flood,
+                     bool *stopped) {
+    *stopped = false;
+    if (cellSetAdd(flood, start) < 0) {
+        return 1;
+    }
+    // The members of the flood are also its queue
+    for (size_t i = 0; i < flood->size; i++) {
+        H3Index neighbors[NEIGHBORHOOD_SIZE] = {0};
+        kRing(flood->cells[i], 1, neighbors);
+        for (int j = 0; j < NEIGHBORHOOD_SIZE; j++) {
+            if (neighbors[j] == 0 ||
+                cellSetContains(region, neighbors[j]) != inside) {
+                continue;
+            }
+            if (stop != NULL && cellSetContains(stop, neighbors[j])) {
+                *stopped = true;
+                return 0;
+            }
+            int added = cellSetAdd(flood, neighbors[j]);
+            if (added < 0) {
+                return 1;
+            }
+            if (added && flood->size > maxSize) {
+                *stopped = true;
+                return 0;
+            }
+        }
+    }
+    return 0;
+}
+
+int cellComponents(const H3Index *cells, size_t numCells, size_t minSize,
+                   H3Index *out, int *offsets, size_t *numComponents) {
+    CellSet region;
+    CellSet visited = {0};
+    int err = cellSetInit(&region, numCells) || cellSetInit(&visited, 0) ||
+              addCells(cells, numCells, &region);
+
+    size_t written = 0;
+    *numComponents = 0;
+    for (size_t i = 0; i < region.size && !err; i++) {
+        if (cellSetContains(&visited, region.cells[i])) {
+            continue;
+        }
+        CellSet component;
+        bool stopped;
+        err = cellSetInit(&component, 0) ||
+              floodFill(region.cells[i], &region, true, region.size, NULL,
+                        &component, &stopped);
+        for (size_t j = 0; j < component.size && !err; j++) {
+            err = cellSetAdd(&visited, component.cells[j]) < 0;
+        }
+        if (!err && component.size >= minSize) {
+            offsets[*numComponents] = (int)written;
+            for (size_t j = 0; j < component.size; j++) {
+                out[written++] = component.cells[j];
+            }
+            (*numComponents)++;
+        }
+        cellSetDestroy(&component);
+    }
+    offsets[*numComponents] = (int)written;
+
+    cellSetDestroy(&visited);
+    cellSetDestroy(&region);
+    return err;
+}
+
+int fillHoles(const H3Index *cells, size_t numCells, size_t maxHoleSize,
+              CellSet *out) {
+    CellSet region;
+    // Cells outside the region known to be in regions too large to fill
+    CellSet large = {0};
+    int err = cellSetInit(&region, numCells) || cellSetInit(&large, 0) ||
+              addCells(cells, numCells, &region) ||
+              addCells(region.cells, region.size, out);
+
+    // Every hole is next to the region, so the fills start from the
+    // neighbors of each cell of the region.
+    for (size_t i = 0; i < region.size && !err && maxHoleSize > 0; i++) {
+        H3Index neighbors[NEIGHBORHOOD_SIZE] = {0};
+        kRing(region.cells[i], 1, neighbors);
+        for (int j = 0; j < NEIGHBORHOOD_SIZE && !err; j++) {
+            if (neighbors[j] == 0 || cellSetContains(out, neighbors[j]) ||
+                cellSetContains(&large, neighbors[j])) {
+                continue;
+            }
+
+            CellSet flood;
+            bool stopped;
+            err = cellSetInit(&flood, 0) ||
+                  floodFill(neighbors[j], &region, false, maxHoleSize, &large,
+                            &flood, &stopped) ||
+                  addCells(flood.cells, flood.size, stopped ? &large : out);
+            cellSetDestroy(&flood);
+        }
+    }
+
+    cellSetDestroy(&large);
+    cellSetDestroy(&region);
+    if (!err) {
+        cellSetSort(out);
+    }
+    return err;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <stddef.h>
+
+#include "cellSet.h"
+#include "h3api.h"
+
+/**
+ * Finds the connected components of a set of cells of one resolution, where
+ * cells sharing an edge are connected. Components with fewer than minSize
+ * cells are dropped.
+ *
+ * The cells of each component are written to `out` one component after
+ * another, in the order the components are first reached visiting the input
+ * in order. `offsets` must have room for numCells + 1 entries, and is filled
+ * with the position of each component in `out`, followed by the number of
+ * cells written. The number of components is stored in numComponents.
+ *
+ * Invalid cells and duplicates in the input are ignored.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int cellComponents(const H3Index *cells, size_t numCells, size_t minSize,
+                   H3Index *out, int *offsets, size_t *numComponents);
+
+/**
+ * Adds to a set of cells of one resolution the holes in it with at most
+ * maxHoleSize cells. A hole is a connected region of cells not in the set
+ * which is surrounded by the set.
+ *
+ * Each hole is found by a flood fill over the cells outside the set, starting
+ * next to the set, which stops once it has reached more than maxHoleSize
+ * cells. Regions found to be too large are remembered, so the cost is
+ * proportional to the size of the set plus its perimeter times maxHoleSize at
+ * worst, however large the space around the set is.
+ *
+ * Invalid cells in the input are ignored. The output set must be
+ * initialized, and is destroyed by the caller. Its cells are sorted.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int fillHoles(const H3Index *cells, size_t numCells, size_t maxHoleSize,
+              CellSet *out);
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "coordMap.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Minimum number of slots in the hash table.
+ */
+#define COORD_MAP_MIN_CAPACITY 16
+
+/**
+ * Size, in radians, of the grid squares coordinates are hashed by. This is
+ * larger than the tolerance, so coordinates which are the same are always in
+ * the same or adjacent squares.
+ */
+#define COORD_MAP_GRID_RADS 1e-9
+
+typedef struct {
+    int64_t lat;
+    int64_t lon;
+} GridKey;
+
+static GridKey gridKey(const GeoCoord *coord) {
+    GridKey key = {(int64_t)floor(coord->lat / COORD_MAP_GRID_RADS),
+                   (int64_t)floor(coord->lon / COORD_MAP_GRID_RADS)};
+    return key;
+}
+
+/**
+ * Combines and mixes the grid square coordinates, with the finalizer of
+ * MurmurHash3.
+ */
+static size_t gridHash(GridKey key) {
+    uint64_t h = (uint64_t)key.lat * 0x9e3779b97f4a7c15ULL ^ (uint64_t)key.lon;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+static bool sameKey(GridKey a, GridKey b) {
+    return a.lat == b.lat && a.lon == b.lon;
+}
+
+static bool sameCoord(const GeoCoord *a, const GeoCoord *b) {
+    return fabs(a->lat - b->lat) < COORD_MAP_TOLERANCE_RADS &&
+           fabs(a->lon - b->lon) < COORD_MAP_TOLERANCE_RADS;
+}
+
+/**
+ * Inserts the id into the slots, which must have room.
+ */
+static void insertSlot(size_t *slots, size_t capacity, GridKey key,
+                       size_t id) {
+    size_t mask = capacity - 1;
+    size_t i = gridHash(key) & mask;
+    while (slots[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = id + 1;
+}
+
+int coordMapInit(CoordMap *map, size_t expected) {
+    size_t capacity = COORD_MAP_MIN_CAPACITY;
+    // Keep the load factor at or below one half
+    while (capacity < expected * 2) {
+        capacity <<= 1;
+    }
+
+    map->slots = calloc(capacity, sizeof(size_t));
+    map->coords = malloc((capacity / 2) * sizeof(GeoCoord));
+    map->capacity = capacity;
+    map->size = 0;
+    if (map->slots == NULL || map->coords == NULL) {
+        coordMapDestroy(map);
+        return 1;
+    }
+    return 0;
+}
+
+void coordMapDestroy(CoordMap *map) {
+    free(map->slots);
+    free(map->coords);
+    map->slots = NULL;
+    map->coords = NULL;
+    map->capacity = 0;
+    map->size = 0;
+}
+
+/**
+ * Doubles the capacity of the map. Returns 0 on success.
+ */
+static int grow(CoordMap *map) {
+    size_t capacity = map->capacity * 2;
+    size_t *slots = calloc(capacity, sizeof(size_t));
+    if (slots == NULL) {
+        return 1;
+    }
+    GeoCoord *coords =
+        realloc(map->coords, (capacity / 2) * sizeof(GeoCoord));
+    if (coords == NULL) {
+        free(slots);
+        return 1;
+    }
+    for (size_t i = 0; i < map->size; i++) {
+        insertSlot(slots, capacity, gridKey(&coords[i]), i);
+    }
+    free(map->slots);
+    map->slots = slots;
+    map->coords = coords;
+    map->capacity = capacity;
+    return 0;
+}
+
+/**
+ * Searches the grid square for a coordinate within the tolerance.
+ */
+static bool findInSquare(const CoordMap *map, GridKey key,
+                         const GeoCoord *coord, size_t *id) {
+    size_t mask = map->capacity - 1;
+    size_t i = gridHash(key) & mask;
+    while (map->slots[i] != 0) {
+        const GeoCoord *candidate = &map->coords[map->slots[i] - 1];
+        if (sameKey(gridKey(candidate), key) && sameCoord(candidate, coord)) {
+            *id = map->slots[i] - 1;
+            return true;
+        }
+        i = (i + 1) & mask;
+    }
+    return false;
+}
+
+int coordMapAdd(CoordMap *map, const GeoCoord *coord, size_t *id) {
+    GridKey key = gridKey(coord);
+    for (int64_t dLat = -1; dLat <= 1; dLat++) {
+        for (int64_t dLon = -1; dLon <= 1; dLon++) {
+            GridKey square = {key.lat + dLat, key.lon + dLon};
+            if (findInSquare(map, square, coord, id)) {
+                return 0;
+            }
+        }
+    }
+
+    if (map->size + 1 > map->capacity / 2 && grow(map)) {
+        return 1;
+    }
+    map->coords[map->size] = *coord;
+    insertSlot(map->slots, map->capacity, key, map->size);
+    *id = map->size;
+    map->size++;
+    return 0;
+}
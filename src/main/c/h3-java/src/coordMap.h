@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COORDMAP_H
+#define COORDMAP_H
+
+#include <stddef.h>
+
+#include "h3api.h"
+
+/**
+ * Coordinates closer than this in both latitude and longitude (radians) are
+ * treated as the same, since cell vertices computed from different cells may
+ * differ in their last bits.
+ */
+#define COORD_MAP_TOLERANCE_RADS 1e-11
+
+/**
+ * Assigns consecutive ids to distinct coordinates, using an open addressing
+ * hash table over a grid of the coordinates.
+ *
+ * The coordinate with id i is `coords[i]`.
+ */
+typedef struct {
+    // Slots of the hash table, holding ids plus one. 0 marks an empty slot.
+    // Capacity is always a power of two.
+    size_t *slots;
+    size_t capacity;
+    // Coordinates, in the order they were added
+    GeoCoord *coords;
+    size_t size;
+} CoordMap;
+
+/**
+ * Initializes an empty map with room for at least `expected` coordinates.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int coordMapInit(CoordMap *map, size_t expected);
+
+/**
+ * Frees the memory held by the map.
+ */
+void coordMapDestroy(CoordMap *map);
+
+/**
+ * Finds the id of the coordinate, adding it if no coordinate within the
+ * tolerance is present.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int coordMapAdd(CoordMap *map, const GeoCoord *coord, size_t *id);
+
+#endif
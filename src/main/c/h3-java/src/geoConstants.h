@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GEOCONSTANTS_H
+#define GEOCONSTANTS_H
+
+/**
+ * Constants matching those of the core library, which are not part of its
+ * public API. M_PI is not defined by all compilers, so these are used instead.
+ */
+
+/** pi */
+#define GEO_PI 3.14159265358979323846
+/** pi / 2 */
+#define GEO_PI_2 1.5707963267948966
+/** 2 * pi */
+#define GEO_2PI 6.28318530717958647692528676655900576839433
+
+/** Earth radius in kilometers, using the WGS84 authalic radius */
+#define GEO_EARTH_RADIUS_KM 6371.007180918475
+
+/** Earth radius in meters */
+#define GEO_EARTH_RADIUS_M (GEO_EARTH_RADIUS_KM * 1000.0)
+
+#endif
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geoToH3Approx.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "geoConstants.h"
+
+/**
+ * Maximum number of edges of a cell that can be tested without the exact
+ * projection. Cells with distortion vertices are always indexed exactly.
+ */
+#define APPROX_MAX_EDGES 6
+
+/**
+ * Maximum number of entries in the cell cache. Must be a power of two.
+ */
+#define APPROX_MAX_CACHE_SIZE 16384
+
+/**
+ * Coordinates larger than this (in radians) are not range reduced, and are
+ * indexed exactly.
+ */
+#define APPROX_MAX_ANGLE 64.0
+
+// pi/2 split into two parts for range reduction, as in fdlibm. PIO2_HI has
+// 33 significant bits, so multiplying it by small integers is exact.
+static const double PIO2_HI = 1.57079632673412561417e+00;
+static const double PIO2_LO = 6.07710050650619224932e-11;
+static const double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+/**
+ * A recently found cell, and the unit normals of the great circles its edges
+ * lie on. The normals point towards the inside of the cell.
+ */
+typedef struct {
+    H3Index cell;
+    // 0 if the cell cannot be tested without the exact projection
+    int numEdges;
+    double normals[APPROX_MAX_EDGES][3];
+} ApproxCacheEntry;
+
+/**
+ * Computes the sine and cosine of x, which must be no larger than
+ * APPROX_MAX_ANGLE. x is reduced to [-pi/4, pi/4] and Taylor polynomials are
+ * used, so the absolute error is below 1e-13.
+ */
+static void approxSinCos(double x, double *outSin, double *outCos) {
+    double k = floor(x * TWO_OVER_PI + 0.5);
+    double r = (x - k * PIO2_HI) - k * PIO2_LO;
+    double r2 = r * r;
+
+    double s =
+        r * (1.0 +
+             r2 * (-1.0 / 6.0 +
+                   r2 * (1.0 / 120.0 +
+                         r2 * (-1.0 / 5040.0 +
+                               r2 * (1.0 / 362880.0 +
+                                     r2 * (-1.0 / 39916800.0 +
+                                           r2 * (1.0 / 6227020800.0)))))));
+    double c =
+        1.0 +
+        r2 * (-1.0 / 2.0 +
+              r2 * (1.0 / 24.0 +
+                    r2 * (-1.0 / 720.0 +
+                          r2 * (1.0 / 40320.0 +
+                                r2 * (-1.0 / 3628800.0 +
+                                      r2 * (1.0 / 479001600.0 +
+                                            r2 * (-1.0 / 87178291200.0)))))));
+
+    // x = r + k * pi / 2
+    switch (((int)k) & 3) {
+        case 0:
+            *outSin = s;
+            *outCos = c;
+            break;
+        case 1:
+            *outSin = c;
+            *outCos = -s;
+            break;
+        case 2:
+            *outSin = -s;
+            *outCos = -c;
+            break;
+        default:
+            *outSin = -c;
+            *outCos = s;
+            break;
+    }
+}
+
+/**
+ * Unit vector of the coordinate, using approxSinCos.
+ */
+static void approxGeoToVec3(const GeoCoord *geo, double v[3]) {
+    double sinLat, cosLat, sinLon, cosLon;
+    approxSinCos(geo->lat, &sinLat, &cosLat);
+    approxSinCos(geo->lon, &sinLon, &cosLon);
+    v[0] = cosLat * cosLon;
+    v[1] = cosLat * sinLon;
+    v[2] = sinLat;
+}
+
+/**
+ * Unit vector of the coordinate, using the exact trigonometric functions.
+ */
+static void geoToVec3(const GeoCoord *geo, double v[3]) {
+    double cosLat = cos(geo->lat);
+    v[0] = cosLat * cos(geo->lon);
+    v[1] = cosLat * sin(geo->lon);
+    v[2] = sin(geo->lat);
+}
+
+static double dot3(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * Finds the cache slot for a coordinate, by hashing the cell of a grid of
+ * approximately cell sized buckets that the coordinate is in.
+ */
+static size_t approxBucket(const GeoCoord *geo, double bucketSize) {
+    uint64_t y = (uint64_t)(int64_t)floor(geo->lat / bucketSize);
+    uint64_t x = (uint64_t)(int64_t)floor(geo->lon / bucketSize);
+    uint64_t h = y * 0x9E3779B97F4A7C15ULL ^ x * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 29;
+    return (size_t)h;
+}
+
+/**
+ * Replaces the cache entry with the given cell, computing its edge normals.
+ */
+static void fillCacheEntry(H3Index cell, ApproxCacheEntry *entry) {
+    entry->cell = cell;
+    entry->numEdges = 0;
+
+    GeoBoundary boundary;
+    h3ToGeoBoundary(cell, &boundary);
+    // Cells with distortion vertices may not be convex, so the half-space
+    // tests below would not be valid for them.
+    if (boundary.numVerts > APPROX_MAX_EDGES) {
+        return;
+    }
+
+    double verts[APPROX_MAX_EDGES][3];
+    double centroid[3] = {0, 0, 0};
+    for (int i = 0; i < boundary.numVerts; i++) {
+        geoToVec3(&boundary.verts[i], verts[i]);
+        centroid[0] += verts[i][0];
+        centroid[1] += verts[i][1];
+        centroid[2] += verts[i][2];
+    }
+
+    for (int i = 0; i < boundary.numVerts; i++) {
+        const double *a = verts[i];
+        const double *b = verts[(i + 1) % boundary.numVerts];
+        double *n = entry->normals[i];
+        n[0] = a[1] * b[2] - a[2] * b[1];
+        n[1] = a[2] * b[0] - a[0] * b[2];
+        n[2] = a[0] * b[1] - a[1] * b[0];
+        double len = sqrt(dot3(n, n));
+        if (len == 0) {
+            return;
+        }
+        n[0] /= len;
+        n[1] /= len;
+        n[2] /= len;
+    }
+
+    // Boundaries are counter-clockwise, so the normals should point inward
+    // already. This is checked against the centroid so that the tests can
+    // never be inverted.
+    if (dot3(centroid, entry->normals[0]) < 0) {
+        for (int i = 0; i < boundary.numVerts; i++) {
+            entry->normals[i][0] = -entry->normals[i][0];
+            entry->normals[i][1] = -entry->normals[i][1];
+            entry->normals[i][2] = -entry->normals[i][2];
+        }
+    }
+
+    entry->numEdges = boundary.numVerts;
+}
+
+/**
+ * Returns true if v is inside the cached cell by more than APPROX_EDGE_BAND.
+ */
+static int isInsideEntry(const ApproxCacheEntry *entry, const double v[3]) {
+    for (int i = 0; i < entry->numEdges; i++) {
+        // The normal is a unit vector, so this is the sine of the angular
+        // distance from the edge.
+        if (dot3(entry->normals[i], v) <= APPROX_EDGE_BAND) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int geoToH3Approx(const GeoCoord *coords, int numCoords, int res,
+                  H3Index *out) {
+    int cacheSize = 1;
+    while (cacheSize < numCoords && cacheSize < APPROX_MAX_CACHE_SIZE) {
+        cacheSize <<= 1;
+    }
+    ApproxCacheEntry *cache = calloc(cacheSize, sizeof(ApproxCacheEntry));
+    if (cache == NULL) {
+        return 1;
+    }
+
+    double bucketSize = edgeLengthKm(res) / GEO_EARTH_RADIUS_KM;
+
+    for (int i = 0; i < numCoords; i++) {
+        const GeoCoord *geo = &coords[i];
+
+        // Written so that NaN also takes the exact path
+        if (!(fabs(geo->lat) <= APPROX_MAX_ANGLE &&
+              fabs(geo->lon) <= APPROX_MAX_ANGLE)) {
+            out[i] = geoToH3(geo, res);
+            continue;
+        }
+
+        ApproxCacheEntry *entry =
+            &cache[approxBucket(geo, bucketSize) & (cacheSize - 1)];
+        if (entry->numEdges > 0) {
+            double v[3];
+            approxGeoToVec3(geo, v);
+            if (isInsideEntry(entry, v)) {
+                out[i] = entry->cell;
+                continue;
+            }
+        }
+
+        H3Index cell = geoToH3(geo, res);
+        if (cell != 0 && cell != entry->cell) {
+            fillCacheEntry(cell, entry);
+        }
+        out[i] = cell;
+    }
+
+    free(cache);
+    return 0;
+}
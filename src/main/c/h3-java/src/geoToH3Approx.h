@@ -0,0 +1,41 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GEOTOH3APPROX_H
+#define GEOTOH3APPROX_H
+
+#include "h3api.h"
+
+/**
+ * Points closer than this many radians (about 0.6mm on the Earth) to a cell
+ * edge are always indexed using the exact geoToH3.
+ */
+#define APPROX_EDGE_BAND 1e-10
+
+/**
+ * Indexes each of the coordinates (in radians) at the given resolution.
+ *
+ * Points are tested against the edges of recently found cells, using
+ * polynomial sine and cosine instead of the projection used by geoToH3. Points
+ * which are not clearly inside a recently found cell, and points within
+ * APPROX_EDGE_BAND of its edges, are indexed using geoToH3.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int geoToH3Approx(const GeoCoord *coords, int numCoords, int res,
+                  H3Index *out);
+
+#endif
@@ -15,9 +15,26 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 
+#include "batch.h"
+#include "cellBBox.h"
+#include "cellSet.h"
+#include "coordMap.h"
 #include "com_uber_h3core_NativeMethods.h"
+#include "components.h"
+#include "geoConstants.h"
+#include "geoToH3Approx.h"
 #include "h3api.h"
+#include "mesh.h"
+#include "morphology.h"
+#include "outline.h"
+#include "planar.h"
+#include "polyfill.h"
+#include "polyline.h"
+#include "preparedPolygon.h"
+#include "regionBoundary.h"
+#include "simplify.h"
 
 /**
  * Maximum number of directions from an H3 index.
@@ -33,6 +50,16 @@
         return;                        \
     }
 
+#ifdef H3_JAVA_STATIC
+/**
+ * Called when the library is linked statically, such as into a GraalVM native
+ * image, and loaded with System.loadLibrary("h3java").
+ */
+JNIEXPORT jint JNICALL JNI_OnLoad_h3java(JavaVM *vm, void *reserved) {
+    return JNI_VERSION_1_8;
+}
+#endif
+
 /**
  * Triggers an OutOfMemoryError.
  *
@@ -60,6 +87,20 @@ void ThrowOutOfMemoryError(JNIEnv *env) {
     }
 }
 
+/**
+ * Triggers an IllegalArgumentException with the message.
+ *
+ * Calling function should return the Java control immediately after calling
+ * this.
+ */
+void ThrowIllegalArgumentException(JNIEnv *env, const char *message) {
+    jclass iae = (**env).FindClass(env, "java/lang/IllegalArgumentException");
+
+    if (iae != NULL) {
+        (**env).ThrowNew(env, iae, message);
+    }
+}
+
 /**
  * Populates the given GeoPolygon
  *
@@ -131,6 +172,76 @@ void DestroyGeoPolygon(JNIEnv *env, jdoubleArray verts,
     free(polygon->holes);
 }
 
+/**
+ * Creates a new Java long array with the members of the set, in the order they
+ * were added.
+ *
+ * Returns NULL if an exception is pending.
+ */
+jlongArray CellSetToManaged(JNIEnv *env, const CellSet *set) {
+    jlongArray result = (**env).NewLongArray(env, (jsize)set->size);
+    if (result != NULL) {
+        (**env).SetLongArrayRegion(env, result, 0, (jsize)set->size,
+                                   (const jlong *)set->cells);
+    }
+    return result;
+}
+
+/**
+ * Creates a new Java long array with the members of each of the sets, one
+ * after another, and fills resultOffsets (of length numSets + 1) with the
+ * position of each set in the array.
+ *
+ * Returns NULL if an exception is pending.
+ */
+jlongArray CellSetsToManaged(JNIEnv *env, const CellSet *sets, jsize numSets,
+                             jintArray resultOffsets) {
+    size_t totalCells = 0;
+    for (jsize i = 0; i < numSets; i++) {
+        totalCells += sets[i].size;
+    }
+    if (totalCells > INT32_MAX) {
+        ThrowOutOfMemoryError(env);
+        return NULL;
+    }
+
+    jlongArray result = (**env).NewLongArray(env, (jsize)totalCells);
+    if (result == NULL) {
+        return NULL;
+    }
+    jint *resultOffsetsElements =
+        (**env).GetIntArrayElements(env, resultOffsets, 0);
+    if (resultOffsetsElements == NULL) {
+        ThrowOutOfMemoryError(env);
+        return NULL;
+    }
+
+    jsize offset = 0;
+    for (jsize i = 0; i < numSets; i++) {
+        resultOffsetsElements[i] = offset;
+        (**env).SetLongArrayRegion(env, result, offset, (jsize)sets[i].size,
+                                   (const jlong *)sets[i].cells);
+        offset += (jsize)sets[i].size;
+    }
+    resultOffsetsElements[numSets] = offset;
+
+    (**env).ReleaseIntArrayElements(env, resultOffsets, resultOffsetsElements,
+                                    0);
+    return result;
+}
+
+/**
+ * Destroys each of the sets, and frees the array. sets may be NULL.
+ */
+void DestroyCellSets(CellSet *sets, jsize numSets) {
+    if (sets != NULL) {
+        for (jsize i = 0; i < numSets; i++) {
+            cellSetDestroy(&sets[i]);
+        }
+        free(sets);
+    }
+}
+
 /*
  * Class:     com_uber_h3core_NativeMethods
  * Method:    h3IsValid
@@ -172,6 +283,232 @@ JNIEXPORT jlong JNICALL Java_com_uber_h3core_NativeMethods_geoToH3(
     return geoToH3(&geo, res);
 }
 
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    geoToH3Batch
+ * Signature: ([DII[J)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_geoToH3Batch(
+    JNIEnv *env, jobject thiz, jdoubleArray coords, jint res, jint numThreads,
+    jlongArray results) {
+    jsize numCoords = (**env).GetArrayLength(env, results);
+    jdouble *coordsElements = (**env).GetDoubleArrayElements(env, coords, 0);
+
+    if (coordsElements != NULL) {
+        jlong *resultsElements =
+            (**env).GetLongArrayElements(env, results, 0);
+
+        if (resultsElements != NULL) {
+            // GeoCoord is a pair of doubles, so the interleaved array can be
+            // used directly.
+            geoToH3Batch((GeoCoord *)coordsElements, numCoords, res,
+                         numThreads, resultsElements);
+
+            (**env).ReleaseLongArrayElements(env, results, resultsElements,
+                                             0);
+        } else {
+            ThrowOutOfMemoryError(env);
+        }
+
+        // coords is not modified, so there is no need to copy it back.
+        (**env).ReleaseDoubleArrayElements(env, coords, coordsElements,
+                                           JNI_ABORT);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    geoToH3BatchApprox
+ * Signature: ([DI[J)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_geoToH3BatchApprox(
+    JNIEnv *env, jobject thiz, jdoubleArray coords, jint res,
+    jlongArray results) {
+    jsize numCoords = (**env).GetArrayLength(env, results);
+    jdouble *coordsElements = (**env).GetDoubleArrayElements(env, coords, 0);
+
+    if (coordsElements != NULL) {
+        jlong *resultsElements =
+            (**env).GetLongArrayElements(env, results, 0);
+
+        if (resultsElements != NULL) {
+            int err = geoToH3Approx((GeoCoord *)coordsElements, numCoords, res,
+                                    resultsElements);
+
+            (**env).ReleaseLongArrayElements(env, results, resultsElements,
+                                             0);
+
+            if (err) {
+                ThrowOutOfMemoryError(env);
+            }
+        } else {
+            ThrowOutOfMemoryError(env);
+        }
+
+        // coords is not modified, so there is no need to copy it back.
+        (**env).ReleaseDoubleArrayElements(env, coords, coordsElements,
+                                           JNI_ABORT);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    h3ToGeoBatch
+ * Signature: ([JI[D)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_h3ToGeoBatch(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint numThreads,
+    jdoubleArray results) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jdouble *resultsElements =
+        (**env).GetDoubleArrayElements(env, results, 0);
+
+    if (h3Elements != NULL && resultsElements != NULL) {
+        h3ToGeoBatch(h3Elements, numH3, numThreads,
+                     (GeoCoord *)resultsElements);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    if (resultsElements != NULL) {
+        (**env).ReleaseDoubleArrayElements(env, results, resultsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    h3ToGeoBoundaryBatch
+ * Signature: ([JI[I[D)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_h3ToGeoBoundaryBatch(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint numThreads,
+    jintArray offsets, jdoubleArray results) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jint *offsetsElements = (**env).GetIntArrayElements(env, offsets, 0);
+    jdouble *resultsElements =
+        (**env).GetDoubleArrayElements(env, results, 0);
+
+    if (h3Elements != NULL && offsetsElements != NULL &&
+        resultsElements != NULL) {
+        h3ToGeoBoundaryBatch(h3Elements, numH3, numThreads, offsetsElements,
+                             (GeoCoord *)resultsElements);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    if (resultsElements != NULL) {
+        (**env).ReleaseDoubleArrayElements(env, results, resultsElements, 0);
+    }
+    if (offsetsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, offsets, offsetsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellAreaBatch
+ * Signature: ([JII[D)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_cellAreaBatch(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint unit, jint numThreads,
+    jdoubleArray results) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jdouble *resultsElements =
+        (**env).GetDoubleArrayElements(env, results, 0);
+
+    if (h3Elements != NULL && resultsElements != NULL) {
+        cellAreaBatch(h3Elements, numH3, unit, numThreads, resultsElements);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    if (resultsElements != NULL) {
+        (**env).ReleaseDoubleArrayElements(env, results, resultsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    h3ToParentBatch
+ * Signature: ([JII[J)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_h3ToParentBatch(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint res, jint numThreads,
+    jlongArray results) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jlong *resultsElements = (**env).GetLongArrayElements(env, results, 0);
+
+    if (h3Elements != NULL && resultsElements != NULL) {
+        h3ToParentBatch(h3Elements, numH3, res, numThreads, resultsElements);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    if (resultsElements != NULL) {
+        (**env).ReleaseLongArrayElements(env, results, resultsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    h3DistanceBatch
+ * Signature: ([J[JI[I)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_h3DistanceBatch(
+    JNIEnv *env, jobject thiz, jlongArray origins, jlongArray destinations,
+    jint numThreads, jintArray results) {
+    jsize numPairs = (**env).GetArrayLength(env, origins);
+    jlong *originsElements = (**env).GetLongArrayElements(env, origins, 0);
+    jlong *destinationsElements =
+        (**env).GetLongArrayElements(env, destinations, 0);
+    jint *resultsElements = (**env).GetIntArrayElements(env, results, 0);
+
+    if (originsElements != NULL && destinationsElements != NULL &&
+        resultsElements != NULL) {
+        h3DistanceBatch(originsElements, destinationsElements, numPairs,
+                        numThreads, resultsElements);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    if (resultsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, results, resultsElements, 0);
+    }
+    // The inputs are not modified, so there is no need to copy them back.
+    if (destinationsElements != NULL) {
+        (**env).ReleaseLongArrayElements(env, destinations,
+                                         destinationsElements, JNI_ABORT);
+    }
+    if (originsElements != NULL) {
+        (**env).ReleaseLongArrayElements(env, origins, originsElements,
+                                         JNI_ABORT);
+    }
+}
+
 /*
  * Class:     com_uber_h3core_NativeMethods
  * Method:    h3ToGeo
@@ -524,6 +861,248 @@ JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_polyfill(
     DestroyGeoPolygon(env, verts, holeSizes, holeVerts, &polygon);
 }
 
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    createPreparedPolygon
+ * Signature: ([D[I[D)J
+ */
+JNIEXPORT jlong JNICALL
+Java_com_uber_h3core_NativeMethods_createPreparedPolygon(
+    JNIEnv *env, jobject thiz, jdoubleArray verts, jintArray holeSizes,
+    jdoubleArray holeVerts) {
+    GeoPolygon polygon;
+    if (CreateGeoPolygon(env, verts, holeSizes, holeVerts, &polygon)) {
+        return 0;
+    }
+
+    // The prepared polygon copies the vertices, so it does not keep the Java
+    // arrays pinned.
+    PreparedPolygon *prepared = malloc(sizeof(PreparedPolygon));
+    if (prepared != NULL && preparedPolygonCreate(&polygon, prepared)) {
+        free(prepared);
+        prepared = NULL;
+    }
+
+    DestroyGeoPolygon(env, verts, holeSizes, holeVerts, &polygon);
+
+    if (prepared == NULL) {
+        ThrowOutOfMemoryError(env);
+        return 0;
+    }
+    return (jlong)(intptr_t)prepared;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    destroyPreparedPolygon
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL
+Java_com_uber_h3core_NativeMethods_destroyPreparedPolygon(JNIEnv *env,
+                                                          jobject thiz,
+                                                          jlong polygon) {
+    PreparedPolygon *prepared = (PreparedPolygon *)(intptr_t)polygon;
+    if (prepared != NULL) {
+        preparedPolygonDestroy(prepared);
+        free(prepared);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    preparedPolygonContains
+ * Signature: (JDD)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_uber_h3core_NativeMethods_preparedPolygonContains(JNIEnv *env,
+                                                           jobject thiz,
+                                                           jlong polygon,
+                                                           jdouble lat,
+                                                           jdouble lng) {
+    GeoCoord coord = {lat, lng};
+    return preparedPolygonContains((PreparedPolygon *)(intptr_t)polygon,
+                                   &coord);
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    polyfillPrepared
+ * Signature: (JI)[J
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_uber_h3core_NativeMethods_polyfillPrepared(JNIEnv *env, jobject thiz,
+                                                    jlong polygon, jint res) {
+    CellSet cells;
+    if (cellSetInit(&cells, 0)) {
+        ThrowOutOfMemoryError(env);
+        return NULL;
+    }
+
+    jlongArray result = NULL;
+    if (polyfillPrepared((PreparedPolygon *)(intptr_t)polygon, res, &cells)) {
+        ThrowOutOfMemoryError(env);
+    } else {
+        result = CellSetToManaged(env, &cells);
+    }
+
+    cellSetDestroy(&cells);
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    polyfillBBox
+ * Signature: (DDDDI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_uber_h3core_NativeMethods_polyfillBBox(
+    JNIEnv *env, jobject thiz, jdouble south, jdouble west, jdouble north,
+    jdouble east, jint res) {
+    CellSet cells;
+    if (cellSetInit(&cells, 0)) {
+        ThrowOutOfMemoryError(env);
+        return NULL;
+    }
+
+    LatLngBox box = {north, south, east, west};
+    jlongArray result = NULL;
+    if (polyfillBBox(&box, res, &cells)) {
+        ThrowOutOfMemoryError(env);
+    } else {
+        result = CellSetToManaged(env, &cells);
+    }
+
+    cellSetDestroy(&cells);
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    polyfillCircle
+ * Signature: (DDDI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_uber_h3core_NativeMethods_polyfillCircle(
+    JNIEnv *env, jobject thiz, jdouble lat, jdouble lng, jdouble radiusMeters,
+    jint res) {
+    CellSet cells;
+    if (cellSetInit(&cells, 0)) {
+        ThrowOutOfMemoryError(env);
+        return NULL;
+    }
+
+    GeoCoord center = {lat, lng};
+    jlongArray result = NULL;
+    if (polyfillCircle(&center, radiusMeters / GEO_EARTH_RADIUS_M, res,
+                       &cells)) {
+        ThrowOutOfMemoryError(env);
+    } else {
+        result = CellSetToManaged(env, &cells);
+    }
+
+    cellSetDestroy(&cells);
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    polyfillBatch
+ * Signature: ([D[I[III[I)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_uber_h3core_NativeMethods_polyfillBatch(
+    JNIEnv *env, jobject thiz, jdoubleArray verts, jintArray ringOffsets,
+    jintArray polygonOffsets, jint res, jint numThreads,
+    jintArray resultOffsets) {
+    jsize numPolygons = (**env).GetArrayLength(env, resultOffsets) - 1;
+
+    jdouble *vertsElements = (**env).GetDoubleArrayElements(env, verts, 0);
+    jint *ringOffsetsElements =
+        (**env).GetIntArrayElements(env, ringOffsets, 0);
+    jint *polygonOffsetsElements =
+        (**env).GetIntArrayElements(env, polygonOffsets, 0);
+    CellSet *cells = calloc(numPolygons + 1, sizeof(CellSet));
+
+    jlongArray result = NULL;
+    if (vertsElements != NULL && ringOffsetsElements != NULL &&
+        polygonOffsetsElements != NULL && cells != NULL) {
+        PolygonBatch batch = {(GeoCoord *)vertsElements, ringOffsetsElements,
+                              polygonOffsetsElements, numPolygons};
+        if (polyfillBatch(&batch, res, numThreads, cells)) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result =
+                CellSetsToManaged(env, cells, numPolygons, resultOffsets);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    DestroyCellSets(cells, numPolygons);
+    // The inputs are not modified, so there is no need to copy them back.
+    if (polygonOffsetsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, polygonOffsets,
+                                        polygonOffsetsElements, JNI_ABORT);
+    }
+    if (ringOffsetsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, ringOffsets, ringOffsetsElements,
+                                        JNI_ABORT);
+    }
+    if (vertsElements != NULL) {
+        (**env).ReleaseDoubleArrayElements(env, verts, vertsElements,
+                                           JNI_ABORT);
+    }
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    polylineToCellsBatch
+ * Signature: ([D[IIDII[I)[J
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_uber_h3core_NativeMethods_polylineToCellsBatch(
+    JNIEnv *env, jobject thiz, jdoubleArray verts, jintArray lineOffsets,
+    jint res, jdouble densifyMeters, jint k, jint numThreads,
+    jintArray resultOffsets) {
+    jsize numLines = (**env).GetArrayLength(env, resultOffsets) - 1;
+
+    jdouble *vertsElements = (**env).GetDoubleArrayElements(env, verts, 0);
+    jint *lineOffsetsElements =
+        (**env).GetIntArrayElements(env, lineOffsets, 0);
+    CellSet *cells = calloc(numLines + 1, sizeof(CellSet));
+
+    jlongArray result = NULL;
+    if (vertsElements != NULL && lineOffsetsElements != NULL &&
+        cells != NULL) {
+        int err = polylineToCellsBatch((GeoCoord *)vertsElements,
+                                       lineOffsetsElements, numLines, res,
+                                       densifyMeters / GEO_EARTH_RADIUS_M, k,
+                                       numThreads, cells);
+        if (err == POLYLINE_ERR_UNDEFINED) {
+            ThrowIllegalArgumentException(
+                env,
+                "Cells along a segment are not defined, as its ends are "
+                "antipodal or the line between cells could not be found");
+        } else if (err) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result = CellSetsToManaged(env, cells, numLines, resultOffsets);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    DestroyCellSets(cells, numLines);
+    // The inputs are not modified, so there is no need to copy them back.
+    if (lineOffsetsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, lineOffsets, lineOffsetsElements,
+                                        JNI_ABORT);
+    }
+    if (vertsElements != NULL) {
+        (**env).ReleaseDoubleArrayElements(env, verts, vertsElements,
+                                           JNI_ABORT);
+    }
+    return result;
+}
+
 /**
  * Converts the given polygon to managed objects
  * (ArrayList<ArrayList<ArrayList<GeoCoord>>>)
@@ -640,6 +1219,391 @@ JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_h3SetToLinkedGeo(
     }
 }
 
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    compactedSetToLinkedGeo
+ * Signature: ([JLjava/util/ArrayList;)V
+ */
+JNIEXPORT void JNICALL
+Java_com_uber_h3core_NativeMethods_compactedSetToLinkedGeo(JNIEnv *env,
+                                                           jobject thiz,
+                                                           jlongArray h3,
+                                                           jobject results) {
+    LinkedGeoPolygon polygon;
+
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+
+    if (h3Elements != NULL) {
+        if (compactedSetToLinkedGeo(h3Elements, numH3, &polygon)) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            ConvertLinkedGeoPolygonToManaged(env, &polygon, results);
+        }
+
+        destroyLinkedPolygon(&polygon);
+
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    h3SetToSimplifiedLinkedGeo
+ * Signature: ([JDLjava/util/ArrayList;)V
+ */
+JNIEXPORT void JNICALL
+Java_com_uber_h3core_NativeMethods_h3SetToSimplifiedLinkedGeo(
+    JNIEnv *env, jobject thiz, jlongArray h3, jdouble toleranceMeters,
+    jobject results) {
+    LinkedGeoPolygon polygon;
+
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+
+    if (h3Elements != NULL) {
+        bool mixedResolutions = false;
+        for (jsize i = 1; i < numH3 && !mixedResolutions; i++) {
+            mixedResolutions = h3GetResolution(h3Elements[i]) !=
+                               h3GetResolution(h3Elements[0]);
+        }
+
+        int err = 0;
+        if (mixedResolutions) {
+            err = compactedSetToLinkedGeo(h3Elements, numH3, &polygon);
+        } else {
+            h3SetToLinkedGeo(h3Elements, numH3, &polygon);
+        }
+        if (err || simplifyLinkedGeo(&polygon,
+                                     toleranceMeters / GEO_EARTH_RADIUS_M)) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            ConvertLinkedGeoPolygonToManaged(env, &polygon, results);
+        }
+
+        destroyLinkedPolygon(&polygon);
+
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    regionBoundary
+ * Signature: ([J[I)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_uber_h3core_NativeMethods_regionBoundary(
+    JNIEnv *env, jobject thiz, jlongArray h3, jintArray resultOffsets) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    // Edges, boundary cells, and exterior cells
+    CellSet results[3] = {0};
+
+    jlongArray result = NULL;
+    if (h3Elements != NULL && !cellSetInit(&results[0], 0) &&
+        !cellSetInit(&results[1], 0) && !cellSetInit(&results[2], 0)) {
+        if (regionBoundary(h3Elements, numH3, &results[0], &results[1],
+                           &results[2])) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result = CellSetsToManaged(env, results, 3, resultOffsets);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        cellSetDestroy(&results[i]);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellsToMesh
+ * Signature: ([J[I[I)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_com_uber_h3core_NativeMethods_cellsToMesh(
+    JNIEnv *env, jobject thiz, jlongArray h3, jintArray offsets,
+    jintArray indices) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jint *offsetsElements = (**env).GetIntArrayElements(env, offsets, 0);
+    jint *indicesElements = (**env).GetIntArrayElements(env, indices, 0);
+    // Neighboring cells share vertices, so there are about two per cell
+    CoordMap vertices = {0};
+
+    jdoubleArray result = NULL;
+    if (h3Elements != NULL && offsetsElements != NULL &&
+        indicesElements != NULL && !coordMapInit(&vertices, 2 * numH3)) {
+        if (cellsToMesh(h3Elements, numH3, &vertices, offsetsElements,
+                        indicesElements)) {
+            ThrowOutOfMemoryError(env);
+        } else if (vertices.size > INT32_MAX / 2) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result = (**env).NewDoubleArray(env, (jsize)vertices.size * 2);
+            if (result != NULL) {
+                (**env).SetDoubleArrayRegion(env, result, 0,
+                                             (jsize)vertices.size * 2,
+                                             (const jdouble *)vertices.coords);
+            }
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    coordMapDestroy(&vertices);
+    if (indicesElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, indices, indicesElements, 0);
+    }
+    if (offsetsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, offsets, offsetsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellBBox
+ * Signature: ([J[D)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_cellBBox(
+    JNIEnv *env, jobject thiz, jlongArray h3, jdoubleArray results) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    if (h3Elements != NULL) {
+        jdouble *resultsElements =
+            (**env).GetDoubleArrayElements(env, results, 0);
+        if (resultsElements != NULL) {
+            cellsToBBoxes(h3Elements, numH3, resultsElements);
+            (**env).ReleaseDoubleArrayElements(env, results, resultsElements,
+                                               0);
+        } else {
+            ThrowOutOfMemoryError(env);
+        }
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+}
+
+/**
+ * Copies the coordinates to whichever of the Java arrays is not NULL,
+ * converting them to floats for a float array.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int CoordsToManaged(JNIEnv *env, const double *coords, jsize numCoords,
+                    jdoubleArray doubleResults, jfloatArray floatResults) {
+    if (doubleResults != NULL) {
+        (**env).SetDoubleArrayRegion(env, doubleResults, 0, numCoords,
+                                     coords);
+        return 0;
+    }
+    jfloat *floatElements =
+        (**env).GetFloatArrayElements(env, floatResults, 0);
+    if (floatElements == NULL) {
+        return 1;
+    }
+    for (jsize i = 0; i < numCoords; i++) {
+        floatElements[i] = (jfloat)coords[i];
+    }
+    (**env).ReleaseFloatArrayElements(env, floatResults, floatElements, 0);
+    return 0;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellCentersToPlanar
+ * Signature: ([JDDI[D[F)V
+ */
+JNIEXPORT void JNICALL Java_com_uber_h3core_NativeMethods_cellCentersToPlanar(
+    JNIEnv *env, jobject thiz, jlongArray h3, jdouble originLat,
+    jdouble originLng, jint projection, jdoubleArray doubleResults,
+    jfloatArray floatResults) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    double *coords = malloc(numH3 * 2 * sizeof(double));
+
+    if (h3Elements != NULL && coords != NULL) {
+        GeoCoord origin = {originLat, originLng};
+        PlanarFrame frame;
+        planarFrameInit(&origin, projection, &frame);
+        cellCentersToPlanar(h3Elements, numH3, &frame, coords);
+        if (CoordsToManaged(env, coords, numH3 * 2, doubleResults,
+                            floatResults)) {
+            ThrowOutOfMemoryError(env);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    free(coords);
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellBoundariesToPlanar
+ * Signature: ([JDDI[I[D[F)V
+ */
+JNIEXPORT void JNICALL
+Java_com_uber_h3core_NativeMethods_cellBoundariesToPlanar(
+    JNIEnv *env, jobject thiz, jlongArray h3, jdouble originLat,
+    jdouble originLng, jint projection, jintArray offsets,
+    jdoubleArray doubleResults, jfloatArray floatResults) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jint *offsetsElements = (**env).GetIntArrayElements(env, offsets, 0);
+    double *coords =
+        malloc((size_t)numH3 * MAX_CELL_BNDRY_VERTS * 2 * sizeof(double));
+
+    if (h3Elements != NULL && offsetsElements != NULL && coords != NULL) {
+        GeoCoord origin = {originLat, originLng};
+        PlanarFrame frame;
+        planarFrameInit(&origin, projection, &frame);
+        cellBoundariesToPlanar(h3Elements, numH3, &frame, offsetsElements,
+                               coords);
+        if (CoordsToManaged(env, coords, offsetsElements[numH3] * 2,
+                            doubleResults, floatResults)) {
+            ThrowOutOfMemoryError(env);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    free(coords);
+    if (offsetsElements != NULL) {
+        (**env).ReleaseIntArrayElements(env, offsets, offsetsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellMorphology
+ * Signature: ([JIII)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_uber_h3core_NativeMethods_cellMorphology(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint operation, jint k,
+    jint numThreads) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    CellSet cells = {0};
+
+    jlongArray result = NULL;
+    if (h3Elements != NULL && !cellSetInit(&cells, numH3)) {
+        if (cellMorphology(h3Elements, numH3, operation, k, numThreads,
+                           &cells)) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result = CellSetToManaged(env, &cells);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    cellSetDestroy(&cells);
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    cellComponents
+ * Signature: ([JI[J)[I
+ */
+JNIEXPORT jintArray JNICALL Java_com_uber_h3core_NativeMethods_cellComponents(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint minSize,
+    jlongArray results) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    jlong *resultsElements = (**env).GetLongArrayElements(env, results, 0);
+    int *offsets = malloc((numH3 + 1) * sizeof(int));
+
+    jintArray result = NULL;
+    if (h3Elements != NULL && resultsElements != NULL && offsets != NULL) {
+        size_t numComponents;
+        if (cellComponents(h3Elements, numH3, minSize, resultsElements,
+                           offsets, &numComponents)) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result = (**env).NewIntArray(env, (jsize)numComponents + 1);
+            if (result != NULL) {
+                (**env).SetIntArrayRegion(env, result, 0,
+                                          (jsize)numComponents + 1, offsets);
+            }
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    free(offsets);
+    if (resultsElements != NULL) {
+        (**env).ReleaseLongArrayElements(env, results, resultsElements, 0);
+    }
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+    return result;
+}
+
+/*
+ * Class:     com_uber_h3core_NativeMethods
+ * Method:    fillHoles
+ * Signature: ([JI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_uber_h3core_NativeMethods_fillHoles(
+    JNIEnv *env, jobject thiz, jlongArray h3, jint maxHoleSize) {
+    jsize numH3 = (**env).GetArrayLength(env, h3);
+    jlong *h3Elements = (**env).GetLongArrayElements(env, h3, 0);
+    CellSet cells = {0};
+
+    jlongArray result = NULL;
+    if (h3Elements != NULL && !cellSetInit(&cells, numH3)) {
+        if (fillHoles(h3Elements, numH3, maxHoleSize, &cells)) {
+            ThrowOutOfMemoryError(env);
+        } else {
+            result = CellSetToManaged(env, &cells);
+        }
+    } else {
+        ThrowOutOfMemoryError(env);
+    }
+
+    cellSetDestroy(&cells);
+    if (h3Elements != NULL) {
+        // The input is not modified, so there is no need to copy it back.
+        (**env).ReleaseLongArrayElements(env, h3, h3Elements, JNI_ABORT);
+    }
+    return result;
+}
+
 /*
  * Class:     com_uber_h3core_NativeMethods
  * Method:    maxH3ToChildrenSize
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mesh.h"
+
+int cellsToMesh(const H3Index *cells, size_t numCells, CoordMap *vertices,
+                int *offsets, int *indices) {
+    int numIndices = 0;
+    for (size_t i = 0; i < numCells; i++) {
+        offsets[i] = numIndices;
+        // Invalid indexes have no boundary
+        if (!h3IsValid(cells[i])) {
+            continue;
+        }
+
+        GeoBoundary boundary;
+        h3ToGeoBoundary(cells[i], &boundary);
+        for (int v = 0; v < boundary.numVerts; v++) {
+            size_t id;
+            if (coordMapAdd(vertices, &boundary.verts[v], &id)) {
+                return 1;
+            }
+            indices[numIndices++] = (int)id;
+        }
+    }
+    offsets[numCells] = numIndices;
+    return 0;
+}
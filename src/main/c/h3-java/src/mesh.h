@@ -0,0 +1,39 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <stddef.h>
+
+#include "coordMap.h"
+#include "h3api.h"
+
+/**
+ * Creates an indexed mesh of the cells' boundaries, with each vertex shared
+ * by neighboring cells stored once in `vertices`, which must be initialized.
+ *
+ * The boundary of cell i is the vertices with the ids
+ * indices[offsets[i]] to indices[offsets[i + 1] - 1], in the same order as
+ * h3ToGeoBoundary. `offsets` must have room for numCells + 1 values, and
+ * `indices` for numCells * MAX_CELL_BNDRY_VERTS.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int cellsToMesh(const H3Index *cells, size_t numCells, CoordMap *vertices,
+                int *offsets, int *indices);
+
+#endif
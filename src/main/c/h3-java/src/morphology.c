@@ -0,0 +1,232 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morphology.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "parallel.h"
+
+/**
+ * Number of cells within one grid step of a cell, including itself.
+ */
+#define NEIGHBORHOOD_SIZE 7
+
+/**
+ * Number of frontier cells expanded at a time, bounding the memory used for
+ * their neighbors.
+ */
+#define MORPHOLOGY_BLOCK_SIZE 65536
+
+/**
+ * Number of frontier cells below which a block is expanded on the calling
+ * thread, as starting threads would cost more than it saves.
+ */
+#define MORPHOLOGY_MIN_PARALLEL 4096
+
+typedef struct {
+    const H3Index *frontier;
+    const CellSet *region;
+    bool inside;
+    const CellSet *visited;
+    // NEIGHBORHOOD_SIZE slots for each frontier cell
+    H3Index *candidates;
+} LayerContext;
+
+/**
+ * Finds the neighbors of a range of frontier cells which are inside (or
+ * outside) the region and not yet visited. Neighbors which are not are
+ * cleared to 0.
+ *
+ * The sets are only read, so ranges may be expanded concurrently.
+ */
+static int expandRange(void *context, size_t begin, size_t end) {
+    const LayerContext *ctx = (const LayerContext *)context;
+    for (size_t i = begin; i < end; i++) {
+        H3Index *neighbors = &ctx->candidates[i * NEIGHBORHOOD_SIZE];
+        for (int j = 0; j < NEIGHBORHOOD_SIZE; j++) {
+            neighbors[j] = 0;
+        }
+        kRing(ctx->frontier[i], 1, neighbors);
+        for (int j = 0; j < NEIGHBORHOOD_SIZE; j++) {
+            if (neighbors[j] != 0 &&
+                (cellSetContains(ctx->region, neighbors[j]) != ctx->inside ||
+                 (ctx->visited != NULL &&
+                  cellSetContains(ctx->visited, neighbors[j])))) {
+                neighbors[j] = 0;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Finds the cells next to the frontier which are inside (or outside) the
+ * region and not in visited, which may be NULL. `next` is initialized here,
+ * and is destroyed by the caller even on failure.
+ */
+static int expandLayer(const H3Index *frontier, size_t frontierSize,
+                       const CellSet *region, bool inside,
+                       const CellSet *visited, int numThreads, CellSet *next) {
+    if (cellSetInit(next, frontierSize)) {
+        return 1;
+    }
+    if (frontierSize == 0) {
+        return 0;
+    }
+
+    size_t blockSize = frontierSize < MORPHOLOGY_BLOCK_SIZE
+                           ? frontierSize
+                           : MORPHOLOGY_BLOCK_SIZE;
+    H3Index *candidates =
+        malloc(blockSize * NEIGHBORHOOD_SIZE * sizeof(H3Index));
+    if (candidates == NULL) {
+        return 1;
+    }
+
+    int err = 0;
+    for (size_t begin = 0; begin < frontierSize && !err; begin += blockSize) {
+        size_t size = frontierSize - begin < blockSize ? frontierSize - begin
+                                                        : blockSize;
+        LayerContext context = {&frontier[begin], region, inside, visited,
+                                candidates};
+        int threads = size < MORPHOLOGY_MIN_PARALLEL ? 1 : numThreads;
+        parallelFor(size, threads, expandRange, &context);
+
+        for (size_t i = 0; i < size * NEIGHBORHOOD_SIZE && !err; i++) {
+            err = candidates[i] != 0 && cellSetAdd(next, candidates[i]) < 0;
+        }
+    }
+
+    free(candidates);
+    return err;
+}
+
+static int addAll(CellSet *set, const CellSet *cells) {
+    for (size_t i = 0; i < cells->size; i++) {
+        if (cellSetAdd(set, cells->cells[i]) < 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Adds the input and the cells within k of it to out.
+ */
+static int dilate(const CellSet *input, int k, int numThreads, CellSet *out) {
+    if (addAll(out, input)) {
+        return 1;
+    }
+
+    // Each step only expands the cells added by the previous one. Cells
+    // already in out are either in the input or were added by an earlier step.
+    CellSet layer = {0};
+    const H3Index *frontier = input->cells;
+    size_t frontierSize = input->size;
+    int err = 0;
+    for (int step = 0; step < k && frontierSize > 0 && !err; step++) {
+        CellSet next = {0};
+        err = expandLayer(frontier, frontierSize, out, false, NULL, numThreads,
+                          &next) ||
+              addAll(out, &next);
+        cellSetDestroy(&layer);
+        layer = next;
+        frontier = layer.cells;
+        frontierSize = layer.size;
+    }
+    cellSetDestroy(&layer);
+    return err;
+}
+
+/**
+ * Adds the cells of the input not within k of a cell outside it to out.
+ */
+static int erode(const CellSet *input, int k, int numThreads, CellSet *out) {
+    if (k <= 0) {
+        return addAll(out, input);
+    }
+
+    // Starting from the cells just outside the input, each step removes the
+    // cells next to those removed by the previous step.
+    CellSet removed;
+    if (cellSetInit(&removed, 0)) {
+        return 1;
+    }
+    CellSet layer = {0};
+    int err = expandLayer(input->cells, input->size, input, false, NULL,
+                          numThreads, &layer);
+    for (int step = 0; step < k && layer.size > 0 && !err; step++) {
+        CellSet next = {0};
+        err = expandLayer(layer.cells, layer.size, input, true, &removed,
+                          numThreads, &next) ||
+              addAll(&removed, &next);
+        cellSetDestroy(&layer);
+        layer = next;
+    }
+    cellSetDestroy(&layer);
+
+    for (size_t i = 0; i < input->size && !err; i++) {
+        err = !cellSetContains(&removed, input->cells[i]) &&
+              cellSetAdd(out, input->cells[i]) < 0;
+    }
+    cellSetDestroy(&removed);
+    return err;
+}
+
+int cellMorphology(const H3Index *cells, size_t numCells,
+                   MorphologyOperation operation, int k, int numThreads,
+                   CellSet *out) {
+    CellSet input;
+    if (cellSetInit(&input, numCells)) {
+        return 1;
+    }
+    int err = 0;
+    for (size_t i = 0; i < numCells && !err; i++) {
+        err = h3IsValid(cells[i]) && cellSetAdd(&input, cells[i]) < 0;
+    }
+
+    CellSet intermediate = {0};
+    if (!err) {
+        switch (operation) {
+            case MORPHOLOGY_DILATE:
+                err = dilate(&input, k, numThreads, out);
+                break;
+            case MORPHOLOGY_ERODE:
+                err = erode(&input, k, numThreads, out);
+                break;
+            case MORPHOLOGY_OPEN:
+                err = cellSetInit(&intermediate, input.size) ||
+                      erode(&input, k, numThreads, &intermediate) ||
+                      dilate(&intermediate, k, numThreads, out);
+                break;
+            case MORPHOLOGY_CLOSE:
+                err = cellSetInit(&intermediate, input.size) ||
+                      dilate(&input, k, numThreads, &intermediate) ||
+                      erode(&intermediate, k, numThreads, out);
+                break;
+        }
+    }
+    cellSetDestroy(&intermediate);
+    cellSetDestroy(&input);
+
+    if (!err) {
+        cellSetSort(out);
+    }
+    return err;
+}
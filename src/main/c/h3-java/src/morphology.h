@@ -0,0 +1,55 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MORPHOLOGY_H
+#define MORPHOLOGY_H
+
+#include <stddef.h>
+
+#include "cellSet.h"
+#include "h3api.h"
+
+/**
+ * Morphological operations on sets of cells.
+ */
+typedef enum {
+    /** Adds the cells within k of the set */
+    MORPHOLOGY_DILATE = 0,
+    /** Removes the cells within k of a cell outside the set */
+    MORPHOLOGY_ERODE = 1,
+    /** Erodes, then dilates, removing parts narrower than about 2k */
+    MORPHOLOGY_OPEN = 2,
+    /** Dilates, then erodes, filling gaps narrower than about 2k */
+    MORPHOLOGY_CLOSE = 3
+} MorphologyOperation;
+
+/**
+ * Applies the operation to a set of cells of one resolution, with distances
+ * in grid steps. Only the cells near the edge of the set are visited after
+ * the first step, so the cost is proportional to the size of the set plus its
+ * perimeter times k. Each step is divided among up to numThreads threads.
+ *
+ * Invalid cells in the input are ignored. The output set must be
+ * initialized, and is destroyed by the caller. Its cells are sorted.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int cellMorphology(const H3Index *cells, size_t numCells,
+                   MorphologyOperation operation, int k, int numThreads,
+                   CellSet *out);
+
+#endif
@@ -0,0 +1,473 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "outline.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cellSet.h"
+#include "coordMap.h"
+#include "geoConstants.h"
+#include "preparedPolygon.h"
+
+/**
+ * Number of cells in a k = 1 ring, which is also the maximum number of
+ * children at the next resolution.
+ */
+#define RING_1_SIZE 7
+
+/**
+ * Maximum number of edges of a cell.
+ */
+#define MAX_CELL_EDGES 6
+
+/**
+ * Marks the end of a list of segments.
+ */
+#define NO_SEGMENT SIZE_MAX
+
+/**
+ * Cells of the input, which cover the cells of the finest resolution that
+ * are their descendants.
+ */
+typedef struct {
+    CellSet cells;
+    // Bit r is set if there are cells of resolution r
+    int resolutions;
+    int finestRes;
+} CellUnion;
+
+/**
+ * Returns true if the cell, or one of its ancestors, is in the union.
+ */
+static bool unionContains(const CellUnion *u, H3Index cell) {
+    int res = h3GetResolution(cell);
+    for (int r = 0; r <= res; r++) {
+        if ((u->resolutions & (1 << r)) &&
+            cellSetContains(&u->cells, r == res ? cell : h3ToParent(cell, r))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Adds the descendants of the cell at the finest resolution which have a
+ * neighbor outside the union.
+ *
+ * The descendants of a cell only neighbor descendants of the cell and its
+ * neighbors, so if those are all in the union, none of the descendants are on
+ * the perimeter and they are not visited.
+ */
+static int collectPerimeter(const CellUnion *u, H3Index cell,
+                            CellSet *perimeter) {
+    H3Index ring[RING_1_SIZE] = {0};
+    kRing(cell, 1, ring);
+    bool interior = true;
+    for (int i = 0; i < RING_1_SIZE && interior; i++) {
+        // Pentagons have only 5 neighbors
+        interior = ring[i] == 0 || unionContains(u, ring[i]);
+    }
+    if (interior) {
+        return 0;
+    }
+
+    int res = h3GetResolution(cell);
+    if (res == u->finestRes) {
+        return cellSetAdd(perimeter, cell) < 0;
+    }
+    H3Index children[RING_1_SIZE] = {0};
+    h3ToChildren(cell, res + 1, children);
+    for (int i = 0; i < RING_1_SIZE; i++) {
+        if (children[i] != 0 && collectPerimeter(u, children[i], perimeter)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * An edge between a cell in the union and one outside it, directed so the
+ * union is on the left.
+ */
+typedef struct {
+    // Ids of the end points in the coordinate map
+    size_t start;
+    size_t end;
+    // Vertices of the edge, including both end points, in `vertices`
+    size_t firstVertex;
+    int numVertices;
+    // Next segment with the same start, or NO_SEGMENT
+    size_t nextOut;
+    bool used;
+} Segment;
+
+typedef struct {
+    CoordMap coords;
+    Segment *segments;
+    size_t numSegments;
+    size_t segmentsCapacity;
+    GeoCoord *vertices;
+    size_t numVertices;
+    size_t verticesCapacity;
+    // Loop l has the vertices loopVertices[loopOffsets[l]] to
+    // loopVertices[loopOffsets[l + 1] - 1]
+    GeoCoord *loopVertices;
+    size_t numLoopVertices;
+    size_t loopVerticesCapacity;
+    size_t *loopOffsets;
+    size_t numLoops;
+    size_t loopOffsetsCapacity;
+} Outline;
+
+/**
+ * Ensures the array has room for `needed` elements. Returns 0 on success.
+ */
+static int reserve(void **array, size_t *capacity, size_t needed,
+                   size_t elementSize) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+    size_t newCapacity = *capacity > 0 ? *capacity * 2 : 16;
+    while (newCapacity < needed) {
+        newCapacity *= 2;
+    }
+    void *newArray = realloc(*array, newCapacity * elementSize);
+    if (newArray == NULL) {
+        return 1;
+    }
+    *array = newArray;
+    *capacity = newCapacity;
+    return 0;
+}
+
+static void outlineDestroy(Outline *o) {
+    coordMapDestroy(&o->coords);
+    free(o->segments);
+    free(o->vertices);
+    free(o->loopVertices);
+    free(o->loopOffsets);
+}
+
+/**
+ * Adds a segment with the vertices of the edge's boundary.
+ */
+static int addSegment(Outline *o, H3Index edge) {
+    GeoBoundary boundary;
+    getH3UnidirectionalEdgeBoundary(edge, &boundary);
+    if (boundary.numVerts < 2) {
+        return 0;
+    }
+    if (reserve((void **)&o->segments, &o->segmentsCapacity,
+                o->numSegments + 1, sizeof(Segment)) ||
+        reserve((void **)&o->vertices, &o->verticesCapacity,
+                o->numVertices + boundary.numVerts, sizeof(GeoCoord))) {
+        return 1;
+    }
+
+    Segment *segment = &o->segments[o->numSegments];
+    if (coordMapAdd(&o->coords, &boundary.verts[0], &segment->start) ||
+        coordMapAdd(&o->coords, &boundary.verts[boundary.numVerts - 1],
+                    &segment->end)) {
+        return 1;
+    }
+    segment->firstVertex = o->numVertices;
+    segment->numVertices = boundary.numVerts;
+    segment->nextOut = NO_SEGMENT;
+    segment->used = false;
+    memcpy(&o->vertices[o->numVertices], boundary.verts,
+           boundary.numVerts * sizeof(GeoCoord));
+    o->numVertices += boundary.numVerts;
+    o->numSegments++;
+    return 0;
+}
+
+/**
+ * Adds the edges of the cell whose other side is outside the union.
+ */
+static int addBoundaryEdges(const CellUnion *u, H3Index cell, Outline *o) {
+    H3Index edges[MAX_CELL_EDGES] = {0};
+    getH3UnidirectionalEdgesFromHexagon(cell, edges);
+    for (int i = 0; i < MAX_CELL_EDGES; i++) {
+        // Pentagons have only 5 edges
+        if (edges[i] == 0) {
+            continue;
+        }
+        H3Index destination = getDestinationH3IndexFromUnidirectionalEdge(
+            edges[i]);
+        if (!unionContains(u, destination) && addSegment(o, edges[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Joins the segments end to start into loops.
+ */
+static int chainLoops(Outline *o) {
+    size_t *firstOut = malloc(o->coords.size * sizeof(size_t));
+    if (o->coords.size > 0 && firstOut == NULL) {
+        return 1;
+    }
+    for (size_t v = 0; v < o->coords.size; v++) {
+        firstOut[v] = NO_SEGMENT;
+    }
+    for (size_t s = 0; s < o->numSegments; s++) {
+        o->segments[s].nextOut = firstOut[o->segments[s].start];
+        firstOut[o->segments[s].start] = s;
+    }
+
+    int err = 0;
+    for (size_t s = 0; s < o->numSegments && !err; s++) {
+        if (o->segments[s].used) {
+            continue;
+        }
+        err = reserve((void **)&o->loopOffsets, &o->loopOffsetsCapacity,
+                      o->numLoops + 2, sizeof(size_t));
+        if (err) {
+            break;
+        }
+        o->loopOffsets[o->numLoops] = o->numLoopVertices;
+
+        // Every vertex has as many segments starting as ending at it, so
+        // this only stops on returning to the start.
+        size_t current = s;
+        while (current != NO_SEGMENT && !err) {
+            Segment *segment = &o->segments[current];
+            segment->used = true;
+            // The last vertex is the first of the next segment
+            size_t count = segment->numVertices - 1;
+            err = reserve((void **)&o->loopVertices, &o->loopVerticesCapacity,
+                          o->numLoopVertices + count, sizeof(GeoCoord));
+            if (err) {
+                break;
+            }
+            memcpy(&o->loopVertices[o->numLoopVertices],
+                   &o->vertices[segment->firstVertex],
+                   count * sizeof(GeoCoord));
+            o->numLoopVertices += count;
+
+            size_t *next = &firstOut[segment->end];
+            while (*next != NO_SEGMENT && o->segments[*next].used) {
+                *next = o->segments[*next].nextOut;
+            }
+            current = *next;
+        }
+        o->numLoops++;
+        o->loopOffsets[o->numLoops] = o->numLoopVertices;
+    }
+
+    free(firstOut);
+    return err;
+}
+
+/**
+ * Difference in longitude from a to b, taking the shorter way around.
+ */
+static double lonDelta(double a, double b) {
+    double delta = b - a;
+    if (delta > GEO_PI) {
+        delta -= GEO_2PI;
+    } else if (delta < -GEO_PI) {
+        delta += GEO_2PI;
+    }
+    return delta;
+}
+
+/**
+ * Computes twice the signed area of the loop in latitude and longitude,
+ * which is positive if the loop is counter-clockwise. Loops around a pole
+ * have no well defined area, and set `aroundPole`.
+ */
+static double loopSignedArea(const GeoCoord *verts, size_t numVerts,
+                             bool *aroundPole) {
+    double sum = 0;
+    double lon = verts[0].lon;
+    for (size_t i = 0; i < numVerts; i++) {
+        const GeoCoord *a = &verts[i];
+        const GeoCoord *b = &verts[(i + 1) % numVerts];
+        double nextLon = lon + lonDelta(a->lon, b->lon);
+        sum += (lon - nextLon) * (a->lat + b->lat);
+        lon = nextLon;
+    }
+    *aroundPole = fabs(lon - verts[0].lon) > GEO_PI;
+    return sum;
+}
+
+/**
+ * Appends a loop with the vertices to the polygon.
+ */
+static int addLinkedLoop(LinkedGeoPolygon *polygon, const GeoCoord *verts,
+                         size_t numVerts) {
+    LinkedGeoLoop *loop = calloc(1, sizeof(LinkedGeoLoop));
+    if (loop == NULL) {
+        return 1;
+    }
+    if (polygon->last == NULL) {
+        polygon->first = loop;
+    } else {
+        polygon->last->next = loop;
+    }
+    polygon->last = loop;
+
+    for (size_t i = 0; i < numVerts; i++) {
+        LinkedGeoCoord *coord = calloc(1, sizeof(LinkedGeoCoord));
+        if (coord == NULL) {
+            return 1;
+        }
+        coord->vertex = verts[i];
+        if (loop->last == NULL) {
+            loop->first = coord;
+        } else {
+            loop->last->next = coord;
+        }
+        loop->last = coord;
+    }
+    return 0;
+}
+
+/**
+ * Sorts the loops into outer loops and holes, and finds the smallest outer
+ * loop containing each hole.
+ */
+static int assembleLoops(const Outline *o, LinkedGeoPolygon *out) {
+    double *areas = malloc(o->numLoops * sizeof(double));
+    bool *isHole = malloc(o->numLoops * sizeof(bool));
+    // Outer loop each hole is in, or each outer loop's polygon
+    LinkedGeoPolygon **polygons =
+        calloc(o->numLoops, sizeof(LinkedGeoPolygon *));
+    PreparedPolygon *prepared = calloc(o->numLoops, sizeof(PreparedPolygon));
+    bool *isPrepared = calloc(o->numLoops, sizeof(bool));
+    int err = o->numLoops > 0 && (areas == NULL || isHole == NULL ||
+                                  polygons == NULL || prepared == NULL ||
+                                  isPrepared == NULL);
+
+    LinkedGeoPolygon *lastPolygon = NULL;
+    for (size_t l = 0; l < o->numLoops && !err; l++) {
+        const GeoCoord *verts = &o->loopVertices[o->loopOffsets[l]];
+        size_t numVerts = o->loopOffsets[l + 1] - o->loopOffsets[l];
+        bool aroundPole;
+        areas[l] = loopSignedArea(verts, numVerts, &aroundPole);
+        isHole[l] = !aroundPole && areas[l] < 0;
+        if (isHole[l]) {
+            continue;
+        }
+
+        if (lastPolygon == NULL) {
+            lastPolygon = out;
+        } else {
+            lastPolygon->next = calloc(1, sizeof(LinkedGeoPolygon));
+            if (lastPolygon->next == NULL) {
+                err = 1;
+                break;
+            }
+            lastPolygon = lastPolygon->next;
+        }
+        polygons[l] = lastPolygon;
+        err = addLinkedLoop(lastPolygon, verts, numVerts);
+    }
+
+    for (size_t h = 0; h < o->numLoops && !err; h++) {
+        if (!isHole[h]) {
+            continue;
+        }
+        const GeoCoord *verts = &o->loopVertices[o->loopOffsets[h]];
+        size_t numVerts = o->loopOffsets[h + 1] - o->loopOffsets[h];
+
+        LinkedGeoPolygon *container = NULL;
+        double containerArea = INFINITY;
+        for (size_t l = 0; l < o->numLoops && !err; l++) {
+            if (isHole[l] || fabs(areas[l]) >= containerArea) {
+                continue;
+            }
+            if (!isPrepared[l]) {
+                GeoPolygon polygon = {
+                    {(int)(o->loopOffsets[l + 1] - o->loopOffsets[l]),
+                     &o->loopVertices[o->loopOffsets[l]]},
+                    0,
+                    NULL};
+                err = preparedPolygonCreate(&polygon, &prepared[l]);
+                isPrepared[l] = !err;
+            }
+            if (!err && preparedPolygonContains(&prepared[l], &verts[0])) {
+                container = polygons[l];
+                containerArea = fabs(areas[l]);
+            }
+        }
+
+        // A hole is always inside an outer loop, unless the input is
+        // degenerate, in which case it is kept with the first polygon.
+        if (!err) {
+            err = addLinkedLoop(container != NULL ? container : out, verts,
+                                numVerts);
+        }
+    }
+
+    for (size_t l = 0; l < o->numLoops && isPrepared != NULL; l++) {
+        if (isPrepared[l]) {
+            preparedPolygonDestroy(&prepared[l]);
+        }
+    }
+    free(isPrepared);
+    free(prepared);
+    free(polygons);
+    free(isHole);
+    free(areas);
+    return err;
+}
+
+int compactedSetToLinkedGeo(const H3Index *cells, size_t numCells,
+                            LinkedGeoPolygon *out) {
+    memset(out, 0, sizeof(LinkedGeoPolygon));
+
+    CellUnion u = {0};
+    CellSet perimeter = {0};
+    Outline o = {0};
+    int err = cellSetInit(&u.cells, numCells) ||
+              cellSetInit(&perimeter, 0) || coordMapInit(&o.coords, 0);
+
+    for (size_t i = 0; i < numCells && !err; i++) {
+        if (cells[i] == 0) {
+            continue;
+        }
+        int res = h3GetResolution(cells[i]);
+        u.resolutions |= 1 << res;
+        if (res > u.finestRes) {
+            u.finestRes = res;
+        }
+        err = cellSetAdd(&u.cells, cells[i]) < 0;
+    }
+
+    for (size_t i = 0; i < u.cells.size && !err; i++) {
+        err = collectPerimeter(&u, u.cells.cells[i], &perimeter);
+    }
+    for (size_t i = 0; i < perimeter.size && !err; i++) {
+        err = addBoundaryEdges(&u, perimeter.cells[i], &o);
+    }
+    if (!err) {
+        err = chainLoops(&o) || assembleLoops(&o, out);
+    }
+
+    outlineDestroy(&o);
+    cellSetDestroy(&perimeter);
+    cellSetDestroy(&u.cells);
+    return err;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OUTLINE_H
+#define OUTLINE_H
+
+#include <stddef.h>
+
+#include "h3api.h"
+
+/**
+ * Creates the outline of a set of cells, which may be of mixed resolutions,
+ * as from compact. The result is the same as outlining the set uncompacted to
+ * its finest resolution, but only cells along the perimeter of the set are
+ * uncompacted and traced.
+ *
+ * Loops are in the same form as from h3SetToLinkedGeo: outer loops are
+ * counter-clockwise, and are followed by the holes inside them. `out` must be
+ * destroyed with destroyLinkedPolygon, even on failure.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int compactedSetToLinkedGeo(const H3Index *cells, size_t numCells,
+                            LinkedGeoPolygon *out);
+
+#endif
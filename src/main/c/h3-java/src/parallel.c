@@ -0,0 +1,286 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/**
+ * Upper bound on the number of threads used.
+ */
+#define MAX_THREADS 256
+
+/**
+ * Number of chunks per thread the items are divided into, so that threads
+ * which finish early can take work from slower ones.
+ */
+#define CHUNKS_PER_THREAD 16
+
+typedef struct ParallelState {
+    ParallelBody body;
+    void *context;
+    size_t numItems;
+    size_t chunkSize;
+    // The following are guarded by the lock
+    size_t next;
+    int err;
+#ifdef _WIN32
+    CRITICAL_SECTION lock;
+#else
+    pthread_mutex_t lock;
+#endif
+    // The following are guarded by the pool lock
+    struct ParallelState *nextJob;
+    int helpersWanted;
+    int helpersActive;
+} ParallelState;
+
+/*
+ * The pool: worker threads are started as they are first needed, and then
+ * wait for jobs for the life of the process, so each call does not pay for
+ * starting threads. Calls from several threads may share the pool.
+ */
+#ifdef _WIN32
+static SRWLOCK poolLock = SRWLOCK_INIT;
+static CONDITION_VARIABLE jobPosted = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE helperDone = CONDITION_VARIABLE_INIT;
+#else
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobPosted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t helperDone = PTHREAD_COND_INITIALIZER;
+#endif
+// The following are guarded by the pool lock
+static ParallelState *jobs = NULL;
+static int numWorkers = 0;
+
+static void lockPool(void) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&poolLock);
+#else
+    pthread_mutex_lock(&poolLock);
+#endif
+}
+
+static void unlockPool(void) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&poolLock);
+#else
+    pthread_mutex_unlock(&poolLock);
+#endif
+}
+
+#ifdef _WIN32
+static void waitPool(CONDITION_VARIABLE *cond) {
+    SleepConditionVariableSRW(cond, &poolLock, INFINITE, 0);
+}
+
+static void wakePool(CONDITION_VARIABLE *cond) {
+    WakeAllConditionVariable(cond);
+}
+#else
+static void waitPool(pthread_cond_t *cond) {
+    pthread_cond_wait(cond, &poolLock);
+}
+
+static void wakePool(pthread_cond_t *cond) { pthread_cond_broadcast(cond); }
+#endif
+
+static void lockState(ParallelState *state) {
+#ifdef _WIN32
+    EnterCriticalSection(&state->lock);
+#else
+    pthread_mutex_lock(&state->lock);
+#endif
+}
+
+static void unlockState(ParallelState *state) {
+#ifdef _WIN32
+    LeaveCriticalSection(&state->lock);
+#else
+    pthread_mutex_unlock(&state->lock);
+#endif
+}
+
+/**
+ * Claims and processes chunks until none are left or an error occurs.
+ */
+static void runWorker(ParallelState *state) {
+    while (1) {
+        lockState(state);
+        if (state->err || state->next >= state->numItems) {
+            unlockState(state);
+            return;
+        }
+        size_t begin = state->next;
+        size_t end = begin + state->chunkSize;
+        if (end > state->numItems) {
+            end = state->numItems;
+        }
+        state->next = end;
+        unlockState(state);
+
+        int err = state->body(state->context, begin, end);
+        if (err) {
+            lockState(state);
+            if (!state->err) {
+                state->err = err;
+            }
+            unlockState(state);
+        }
+    }
+}
+
+/**
+ * Waits for jobs which want more helpers, and helps with them, forever.
+ */
+static void runPoolWorker(void) {
+    lockPool();
+    while (1) {
+        ParallelState *job = jobs;
+        while (job != NULL && job->helpersWanted == 0) {
+            job = job->nextJob;
+        }
+        if (job == NULL) {
+            waitPool(&jobPosted);
+            continue;
+        }
+        job->helpersWanted--;
+        job->helpersActive++;
+        unlockPool();
+
+        runWorker(job);
+
+        lockPool();
+        job->helpersActive--;
+        if (job->helpersActive == 0) {
+            wakePool(&helperDone);
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI workerMain(LPVOID arg) {
+    (void)arg;
+    runPoolWorker();
+    return 0;
+}
+#else
+static void *workerMain(void *arg) {
+    (void)arg;
+    runPoolWorker();
+    return NULL;
+}
+#endif
+
+/**
+ * Starts workers until there are at least `wanted`, or one cannot be
+ * started. Must be called with the pool lock held.
+ */
+static void ensureWorkers(int wanted) {
+    while (numWorkers < wanted) {
+#ifdef _WIN32
+        HANDLE thread = CreateThread(NULL, 0, workerMain, NULL, 0, NULL);
+        if (thread == NULL) {
+            return;
+        }
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr)) {
+            return;
+        }
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        int err = pthread_create(&thread, &attr, workerMain, NULL);
+        pthread_attr_destroy(&attr);
+        if (err) {
+            return;
+        }
+#endif
+        numWorkers++;
+    }
+}
+
+int parallelFor(size_t numItems, int numThreads, ParallelBody body,
+                void *context) {
+    if (numThreads > MAX_THREADS) {
+        numThreads = MAX_THREADS;
+    }
+    if ((size_t)numThreads > numItems) {
+        numThreads = (int)numItems;
+    }
+    if (numThreads <= 1) {
+        return numItems > 0 ? body(context, 0, numItems) : 0;
+    }
+
+    ParallelState state;
+    state.body = body;
+    state.context = context;
+    state.numItems = numItems;
+    state.chunkSize = numItems / ((size_t)numThreads * CHUNKS_PER_THREAD);
+    if (state.chunkSize == 0) {
+        state.chunkSize = 1;
+    }
+    state.next = 0;
+    state.err = 0;
+    // The calling thread is also a worker, so one fewer helper is wanted.
+    state.helpersWanted = numThreads - 1;
+    state.helpersActive = 0;
+
+#ifdef _WIN32
+    InitializeCriticalSection(&state.lock);
+#else
+    if (pthread_mutex_init(&state.lock, NULL)) {
+        return body(context, 0, numItems);
+    }
+#endif
+
+    lockPool();
+    ensureWorkers(numThreads - 1);
+    state.nextJob = jobs;
+    jobs = &state;
+    wakePool(&jobPosted);
+    unlockPool();
+
+    runWorker(&state);
+
+    // Stop further helpers joining, and wait for those which did to finish
+    // their chunks, as the state is on this stack.
+    lockPool();
+    ParallelState **link = &jobs;
+    while (*link != &state) {
+        link = &(*link)->nextJob;
+    }
+    *link = state.nextJob;
+    while (state.helpersActive > 0) {
+        waitPool(&helperDone);
+    }
+    unlockPool();
+
+#ifdef _WIN32
+    DeleteCriticalSection(&state.lock);
+#else
+    pthread_mutex_destroy(&state.lock);
+#endif
+
+    return state.err;
+}
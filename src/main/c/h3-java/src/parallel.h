@@ -0,0 +1,43 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+/**
+ * Processes items [begin, end). Returns 0 on success, or nonzero to stop
+ * processing.
+ */
+typedef int (*ParallelBody)(void *context, size_t begin, size_t end);
+
+/**
+ * Calls `body` on ranges covering [0, numItems), using up to `numThreads`
+ * threads including the calling thread. Ranges are handed out in chunks as
+ * threads become free, so items may take differing amounts of time.
+ *
+ * The other threads come from a pool shared by all calls, which is started
+ * as threads are first needed and kept for the life of the process. If
+ * threads cannot be started, or are busy with other calls, the remaining
+ * work is done on the calling thread.
+ *
+ * Returns 0 on success, or the first nonzero value returned by `body`.
+ */
+int parallelFor(size_t numItems, int numThreads, ParallelBody body,
+                void *context);
+
+#endif
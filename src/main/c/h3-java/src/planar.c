@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "planar.h"
+
+#include <math.h>
+
+#include "geoConstants.h"
+
+void planarFrameInit(const GeoCoord *origin, PlanarProjection projection,
+                     PlanarFrame *frame) {
+    double sinLat = sin(origin->lat);
+    double cosLat = cos(origin->lat);
+    double sinLon = sin(origin->lon);
+    double cosLon = cos(origin->lon);
+    frame->projection = projection;
+    frame->up = geoToVec3(origin);
+    Vec3 east = {-sinLon, cosLon, 0};
+    Vec3 north = {-sinLat * cosLon, -sinLat * sinLon, cosLat};
+    frame->east = east;
+    frame->north = north;
+}
+
+void projectToPlanar(const PlanarFrame *frame, const GeoCoord *geo,
+                     double *out) {
+    Vec3 v = geoToVec3(geo);
+    double x = dot(v, frame->east);
+    double y = dot(v, frame->north);
+    if (frame->projection == PLANAR_AZIMUTHAL_EQUIDISTANT) {
+        // Scale the direction from the origin to the great circle distance
+        double sinDistance = hypot(x, y);
+        double distance = atan2(sinDistance, dot(v, frame->up));
+        double scale = sinDistance > 0 ? distance / sinDistance : 1;
+        x *= scale;
+        y *= scale;
+    }
+    out[0] = x * GEO_EARTH_RADIUS_M;
+    out[1] = y * GEO_EARTH_RADIUS_M;
+}
+
+void cellCentersToPlanar(const H3Index *cells, size_t numCells,
+                         const PlanarFrame *frame, double *out) {
+    for (size_t i = 0; i < numCells; i++) {
+        if (!h3IsValid(cells[i])) {
+            out[i * 2] = out[i * 2 + 1] = NAN;
+            continue;
+        }
+        GeoCoord center;
+        h3ToGeo(cells[i], &center);
+        projectToPlanar(frame, &center, &out[i * 2]);
+    }
+}
+
+void cellBoundariesToPlanar(const H3Index *cells, size_t numCells,
+                            const PlanarFrame *frame, int *offsets,
+                            double *out) {
+    int numVerts = 0;
+    for (size_t i = 0; i < numCells; i++) {
+        offsets[i] = numVerts;
+        if (!h3IsValid(cells[i])) {
+            continue;
+        }
+        GeoBoundary boundary;
+        h3ToGeoBoundary(cells[i], &boundary);
+        for (int j = 0; j < boundary.numVerts; j++) {
+            projectToPlanar(frame, &boundary.verts[j], &out[numVerts * 2]);
+            numVerts++;
+        }
+    }
+    offsets[numCells] = numVerts;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PLANAR_H
+#define PLANAR_H
+
+#include <stddef.h>
+
+#include "h3api.h"
+#include "vec3.h"
+
+/**
+ * Projections of the sphere onto a plane tangent to it at an origin, with x
+ * east and y north of the origin, in meters.
+ */
+typedef enum {
+    /**
+     * East, north of the local east-north-up frame: each point is projected
+     * orthogonally onto the tangent plane. Distances near the origin are
+     * accurate, and shrink with distance from it.
+     */
+    PLANAR_ENU = 0,
+    /**
+     * Azimuthal equidistant: distances and directions from the origin are
+     * exact.
+     */
+    PLANAR_AZIMUTHAL_EQUIDISTANT = 1
+} PlanarProjection;
+
+/**
+ * The origin and axes of a projection, on the unit sphere.
+ */
+typedef struct {
+    PlanarProjection projection;
+    Vec3 up;
+    Vec3 east;
+    Vec3 north;
+} PlanarFrame;
+
+/**
+ * Sets up the frame of the projection about the origin.
+ */
+void planarFrameInit(const GeoCoord *origin, PlanarProjection projection,
+                     PlanarFrame *frame);
+
+/**
+ * Projects a point to x and y, in meters.
+ */
+void projectToPlanar(const PlanarFrame *frame, const GeoCoord *geo,
+                     double *out);
+
+/**
+ * Projects the center of each cell, and writes x and y of each to `out`. The
+ * center of an invalid cell is NaN.
+ */
+void cellCentersToPlanar(const H3Index *cells, size_t numCells,
+                         const PlanarFrame *frame, double *out);
+
+/**
+ * Projects the boundary of each cell, and writes x and y of each vertex to
+ * `out`, one cell after another. `out` must have room for
+ * MAX_CELL_BNDRY_VERTS vertices per cell. `offsets` must have room for
+ * numCells + 1 entries, and is filled with the first vertex of each cell,
+ * followed by the number of vertices written. An invalid cell has no
+ * vertices.
+ */
+void cellBoundariesToPlanar(const H3Index *cells, size_t numCells,
+                            const PlanarFrame *frame, int *offsets,
+                            double *out);
+
+#endif
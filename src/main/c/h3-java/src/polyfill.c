@@ -0,0 +1,337 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "polyfill.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "geoConstants.h"
+#include "parallel.h"
+
+/**
+ * Maximum number of pentagons per resolution.
+ */
+#define NUM_PENTAGONS 12
+
+/**
+ * Number of cells in a k = 1 ring.
+ */
+#define RING_1_SIZE 7
+
+/**
+ * Distance from the center of a pentagon to its first vertex, the largest
+ * cell radius at the resolution. This is used by the core library to decide
+ * how finely to sample polygon edges.
+ */
+static double pentagonRadiusKm(int res) {
+    H3Index pentagons[NUM_PENTAGONS] = {0};
+    getPentagonIndexes(res, pentagons);
+
+    GeoCoord center;
+    GeoBoundary boundary;
+    h3ToGeo(pentagons[0], &center);
+    h3ToGeoBoundary(pentagons[0], &boundary);
+    return pointDistKm(&center, boundary.verts);
+}
+
+int addLoopSeeds(const GeoCoord *verts, int numVerts, int res,
+                 CellSet *seeds) {
+    double radiusKm = pentagonRadiusKm(res);
+
+    for (int i = 0; i < numVerts; i++) {
+        GeoCoord origin = verts[i];
+        GeoCoord destination = verts[(i + 1) % numVerts];
+
+        int numSamples =
+            (int)ceil(pointDistKm(&origin, &destination) / (2 * radiusKm));
+        if (numSamples == 0) {
+            numSamples = 1;
+        }
+
+        for (int j = 0; j < numSamples; j++) {
+            // Same interpolation as the core library, so the same cells are
+            // found.
+            GeoCoord interpolate;
+            interpolate.lat = (origin.lat * (numSamples - j) / numSamples) +
+                              (destination.lat * j / numSamples);
+            interpolate.lon = (origin.lon * (numSamples - j) / numSamples) +
+                              (destination.lon * j / numSamples);
+            H3Index cell = geoToH3(&interpolate, res);
+            if (cell != 0 && cellSetAdd(seeds, cell) < 0) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Tests each unvisited neighbor of the cell (and the cell itself), adding
+ * those which satisfy the predicate to `out`.
+ */
+static int expandCell(H3Index cell, CellCenterPredicate predicate,
+                      const void *context, CellSet *visited, CellSet *out) {
+    H3Index ring[RING_1_SIZE] = {0};
+    kRing(cell, 1, ring);
+    for (int i = 0; i < RING_1_SIZE; i++) {
+        // Pentagons have only 5 neighbors
+        if (ring[i] == 0) {
+            continue;
+        }
+
+        int added = cellSetAdd(visited, ring[i]);
+        if (added < 0) {
+            return 1;
+        }
+        if (added == 0) {
+            continue;
+        }
+
+        GeoCoord center;
+        h3ToGeo(ring[i], &center);
+        if (predicate(context, &center) && cellSetAdd(out, ring[i]) < 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int floodFillCells(const H3Index *seeds, size_t numSeeds,
+                   CellCenterPredicate predicate, const void *context,
+                   CellSet *out) {
+    // Cells whose centers have been tested, so each is only tested once.
+    CellSet visited;
+    if (cellSetInit(&visited, numSeeds * RING_1_SIZE)) {
+        return 1;
+    }
+
+    int err = 0;
+    for (size_t i = 0; i < numSeeds && !err; i++) {
+        err = expandCell(seeds[i], predicate, context, &visited, out);
+    }
+    // Cells in `out` are appended as they are found, so this is a breadth
+    // first search over the cells inside.
+    for (size_t i = 0; i < out->size && !err; i++) {
+        err = expandCell(out->cells[i], predicate, context, &visited, out);
+    }
+
+    cellSetDestroy(&visited);
+    return err;
+}
+
+static bool preparedPolygonPredicate(const void *context,
+                                     const GeoCoord *center) {
+    return preparedPolygonContains((const PreparedPolygon *)context, center);
+}
+
+int polyfillPrepared(const PreparedPolygon *polygon, int res, CellSet *out) {
+    CellSet seeds;
+    if (cellSetInit(&seeds, polygon->outer.numVerts)) {
+        return 1;
+    }
+
+    // Holes are traced too, as the core library does, so that areas which
+    // are only connected around a hole are still found.
+    int err = addLoopSeeds(polygon->outer.verts, polygon->outer.numVerts, res,
+                           &seeds);
+    for (int i = 0; i < polygon->numHoles && !err; i++) {
+        err = addLoopSeeds(polygon->holes[i].verts, polygon->holes[i].numVerts,
+                           res, &seeds);
+    }
+
+    if (!err) {
+        err = floodFillCells(seeds.cells, seeds.size, preparedPolygonPredicate,
+                             polygon, out);
+    }
+
+    cellSetDestroy(&seeds);
+    return err;
+}
+
+/**
+ * Spacing, in radians, at which to sample boundaries so that no cell along
+ * the boundary is missed.
+ */
+static double seedSpacingRads(int res) {
+    return edgeLengthKm(res) / GEO_EARTH_RADIUS_KM;
+}
+
+static int addSeed(double lat, double lon, int res, CellSet *seeds) {
+    GeoCoord coord = {lat, lon};
+    H3Index cell = geoToH3(&coord, res);
+    return cell != 0 && cellSetAdd(seeds, cell) < 0;
+}
+
+static bool boxPredicate(const void *context, const GeoCoord *center) {
+    const LatLngBox *box = (const LatLngBox *)context;
+    if (center->lat < box->south || center->lat > box->north) {
+        return false;
+    }
+    if (box->west > box->east) {
+        return center->lon >= box->west || center->lon <= box->east;
+    }
+    return center->lon >= box->west && center->lon <= box->east;
+}
+
+int polyfillBBox(const LatLngBox *box, int res, CellSet *out) {
+    double width = box->east - box->west;
+    if (width < 0) {
+        width += GEO_2PI;
+    }
+    double height = box->north - box->south;
+    double spacing = seedSpacingRads(res);
+    // Spacing is in longitude here, which is never longer on the ground than
+    // the same spacing in latitude.
+    int numLng = (int)ceil(width / spacing);
+    int numLat = (int)ceil(height / spacing);
+
+    CellSet seeds;
+    if (cellSetInit(&seeds, 2 * (size_t)(numLng + numLat) + 1)) {
+        return 1;
+    }
+
+    int err = addSeed(box->south + height / 2, box->west + width / 2, res,
+                      &seeds);
+    for (int i = 0; i <= numLng && !err; i++) {
+        double lon = box->west + (numLng > 0 ? width * i / numLng : 0);
+        err = addSeed(box->south, lon, res, &seeds) ||
+              addSeed(box->north, lon, res, &seeds);
+    }
+    for (int i = 0; i <= numLat && !err; i++) {
+        double lat = box->south + (numLat > 0 ? height * i / numLat : 0);
+        err = addSeed(lat, box->west, res, &seeds) ||
+              addSeed(lat, box->east, res, &seeds);
+    }
+
+    if (!err) {
+        err = floodFillCells(seeds.cells, seeds.size, boxPredicate, box, out);
+    }
+
+    cellSetDestroy(&seeds);
+    return err;
+}
+
+typedef struct {
+    GeoCoord center;
+    double radiusRads;
+} Circle;
+
+static bool circlePredicate(const void *context, const GeoCoord *center) {
+    const Circle *circle = (const Circle *)context;
+    return pointDistRads(&circle->center, center) <= circle->radiusRads;
+}
+
+int polyfillCircle(const GeoCoord *center, double radiusRads, int res,
+                   CellSet *out) {
+    Circle circle = {*center, radiusRads < GEO_PI ? radiusRads : GEO_PI};
+    double circumference = GEO_2PI * fabs(sin(circle.radiusRads));
+    int numSamples = (int)ceil(circumference / seedSpacingRads(res));
+
+    CellSet seeds;
+    if (cellSetInit(&seeds, (size_t)numSamples + 1)) {
+        return 1;
+    }
+
+    int err = addSeed(center->lat, center->lon, res, &seeds);
+
+    // Points on the circle, at evenly spaced bearings from the center
+    double sinLat = sin(center->lat);
+    double cosLat = cos(center->lat);
+    double sinRadius = sin(circle.radiusRads);
+    double cosRadius = cos(circle.radiusRads);
+    for (int i = 0; i < numSamples && !err; i++) {
+        double bearing = GEO_2PI * i / numSamples;
+        double lat =
+            asin(sinLat * cosRadius + cosLat * sinRadius * cos(bearing));
+        double lon = center->lon + atan2(sin(bearing) * sinRadius * cosLat,
+                                         cosRadius - sinLat * sin(lat));
+        err = addSeed(lat, lon, res, &seeds);
+    }
+
+    if (!err) {
+        err = floodFillCells(seeds.cells, seeds.size, circlePredicate, &circle,
+                             out);
+    }
+
+    cellSetDestroy(&seeds);
+    return err;
+}
+
+typedef struct {
+    const PolygonBatch *batch;
+    int res;
+    CellSet *results;
+} PolyfillBatchContext;
+
+/**
+ * Fills the polygons [begin, end) of the batch.
+ */
+static int polyfillBatchRange(void *context, size_t begin, size_t end) {
+    const PolyfillBatchContext *ctx = (const PolyfillBatchContext *)context;
+    const PolygonBatch *batch = ctx->batch;
+
+    for (size_t p = begin; p < end; p++) {
+        int firstRing = batch->polygonOffsets[p];
+        int numRings = batch->polygonOffsets[p + 1] - firstRing;
+        if (numRings == 0) {
+            continue;
+        }
+
+        GeoPolygon polygon;
+        polygon.geofence.numVerts = batch->ringOffsets[firstRing + 1] -
+                                    batch->ringOffsets[firstRing];
+        polygon.geofence.verts =
+            (GeoCoord *)&batch->verts[batch->ringOffsets[firstRing]];
+        polygon.numHoles = numRings - 1;
+        polygon.holes = NULL;
+        if (polygon.numHoles > 0) {
+            polygon.holes = malloc(polygon.numHoles * sizeof(Geofence));
+            if (polygon.holes == NULL) {
+                return 1;
+            }
+            for (int h = 0; h < polygon.numHoles; h++) {
+                int ring = firstRing + 1 + h;
+                polygon.holes[h].numVerts =
+                    batch->ringOffsets[ring + 1] - batch->ringOffsets[ring];
+                polygon.holes[h].verts =
+                    (GeoCoord *)&batch->verts[batch->ringOffsets[ring]];
+            }
+        }
+
+        PreparedPolygon prepared;
+        int err = preparedPolygonCreate(&polygon, &prepared);
+        free(polygon.holes);
+        if (err) {
+            return 1;
+        }
+
+        err = cellSetInit(&ctx->results[p], 0) ||
+              polyfillPrepared(&prepared, ctx->res, &ctx->results[p]);
+        preparedPolygonDestroy(&prepared);
+        if (err) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int polyfillBatch(const PolygonBatch *batch, int res, int numThreads,
+                  CellSet *results) {
+    PolyfillBatchContext context = {batch, res, results};
+    return parallelFor(batch->numPolygons, numThreads, polyfillBatchRange,
+                       &context);
+}
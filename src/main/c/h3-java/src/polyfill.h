@@ -0,0 +1,113 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POLYFILL_H
+#define POLYFILL_H
+
+#include <stdbool.h>
+
+#include "cellSet.h"
+#include "h3api.h"
+#include "preparedPolygon.h"
+
+/**
+ * Returns true if a cell whose center is the given coordinate (in radians)
+ * should be included in the fill.
+ */
+typedef bool (*CellCenterPredicate)(const void *context,
+                                    const GeoCoord *center);
+
+/**
+ * Adds the cells containing points sampled along the loop to the set, as the
+ * core library's polyfill does to find its starting cells.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int addLoopSeeds(const GeoCoord *verts, int numVerts, int res, CellSet *seeds);
+
+/**
+ * Adds to `out` every cell that is connected to one of the seeds through
+ * cells whose centers satisfy the predicate, and whose own center satisfies
+ * the predicate. Seeds are only added if their centers satisfy the predicate.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int floodFillCells(const H3Index *seeds, size_t numSeeds,
+                   CellCenterPredicate predicate, const void *context,
+                   CellSet *out);
+
+/**
+ * Finds the cells of the given resolution whose centers are inside the
+ * polygon, using the same algorithm as the core library's polyfill.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int polyfillPrepared(const PreparedPolygon *polygon, int res, CellSet *out);
+
+/**
+ * A latitude and longitude aligned box, in radians. If west > east, the box
+ * crosses the antimeridian.
+ */
+typedef struct {
+    double north;
+    double south;
+    double east;
+    double west;
+} LatLngBox;
+
+/**
+ * Finds the cells of the given resolution whose centers are inside the box.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int polyfillBBox(const LatLngBox *box, int res, CellSet *out);
+
+/**
+ * Finds the cells of the given resolution whose centers are within
+ * `radiusRads` (great circle distance) of `center`.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int polyfillCircle(const GeoCoord *center, double radiusRads, int res,
+                   CellSet *out);
+
+/**
+ * Polygons in compressed sparse row form.
+ *
+ * Ring r has the vertices verts[ringOffsets[r]] to
+ * verts[ringOffsets[r + 1] - 1]. Polygon p has the rings
+ * polygonOffsets[p] to polygonOffsets[p + 1] - 1, of which the first is the
+ * outline and the rest are holes.
+ */
+typedef struct {
+    const GeoCoord *verts;
+    const int *ringOffsets;
+    const int *polygonOffsets;
+    int numPolygons;
+} PolygonBatch;
+
+/**
+ * Fills each polygon of the batch, using up to `numThreads` threads. The
+ * cells of polygon p are placed in results[p], which must be zero
+ * initialized and destroyed by the caller with cellSetDestroy, even on
+ * failure.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int polyfillBatch(const PolygonBatch *batch, int res, int numThreads,
+                  CellSet *results);
+
+#endif
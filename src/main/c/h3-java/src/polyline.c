@@ -0,0 +1,300 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "polyline.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "geoConstants.h"
+#include "parallel.h"
+#include "vec3.h"
+
+/**
+ * Distance, in radians, stepped past a cell's exit point to find the next
+ * cell.
+ */
+#define WALK_STEP_RADS 1e-9
+
+/**
+ * Number of times the step past an exit point is enlarged when the next cell
+ * is not found, due to rounding near the cell boundary.
+ */
+#define WALK_MAX_RETRIES 8
+
+/**
+ * Relative tolerance for an exit point to be considered within an edge.
+ */
+#define EDGE_TOLERANCE 1e-9
+
+/**
+ * Segments whose ends have a dot product below this, as unit vectors, are
+ * treated as antipodal, as the great circle between them is not defined.
+ */
+#define ANTIPODAL_DOT (-1 + 1e-12)
+
+/**
+ * Point at parameter t along the chord from a in direction d.
+ */
+static Vec3 along(Vec3 a, Vec3 d, double t) {
+    Vec3 v = {a.x + d.x * t, a.y + d.y * t, a.z + d.z * t};
+    return v;
+}
+
+/**
+ * Finds the smallest parameter greater than tMin at which the chord a + t * d
+ * crosses an edge of the cell. Since the great circle arc of the segment is
+ * the projection of the chord, this is where the arc leaves the cell.
+ *
+ * Returns a value greater than 1 if the segment does not leave the cell.
+ */
+static double exitParam(H3Index cell, Vec3 a, Vec3 d, double tMin) {
+    GeoBoundary boundary;
+    h3ToGeoBoundary(cell, &boundary);
+    Vec3 verts[MAX_CELL_BNDRY_VERTS];
+    for (int i = 0; i < boundary.numVerts; i++) {
+        verts[i] = geoToVec3(&boundary.verts[i]);
+    }
+
+    double best = 2;
+    for (int i = 0; i < boundary.numVerts; i++) {
+        Vec3 u = verts[i];
+        Vec3 v = verts[(i + 1) % boundary.numVerts];
+        // Normal of the plane of the edge's great circle
+        Vec3 n = cross(u, v);
+        double denom = dot(n, d);
+        if (denom == 0) {
+            continue;
+        }
+        double t = -dot(n, a) / denom;
+        if (!(t > tMin) || t >= best) {
+            continue;
+        }
+
+        // The crossing is on the edge's great circle, so it is on the edge if
+        // it is between u and v.
+        Vec3 x = along(a, d, t);
+        double tolerance = -EDGE_TOLERANCE * dot(n, n) * sqrt(dot(x, x));
+        if (dot(cross(u, x), n) >= tolerance &&
+            dot(cross(x, v), n) >= tolerance) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+/**
+ * Adds the cells of the line from `start` to `end`, for where the walk could
+ * not follow the segment. Both are neighbors of the cells before and after,
+ * so the path stays contiguous.
+ */
+static int addLine(H3Index start, H3Index end, CellSet *out) {
+    int size = h3LineSize(start, end);
+    if (size < 0) {
+        return POLYLINE_ERR_UNDEFINED;
+    }
+    H3Index *line = malloc(size * sizeof(H3Index));
+    if (line == NULL) {
+        return POLYLINE_ERR_MEMORY;
+    }
+    int err = h3Line(start, end, line) ? POLYLINE_ERR_UNDEFINED : 0;
+    for (int i = 0; i < size && !err; i++) {
+        if (cellSetAdd(out, line[i]) < 0) {
+            err = POLYLINE_ERR_MEMORY;
+        }
+    }
+    free(line);
+    return err;
+}
+
+/**
+ * Adds the cells along the great circle arc from `from` to `to`.
+ */
+static int walkSegment(const GeoCoord *from, const GeoCoord *to, int res,
+                       CellSet *out) {
+    H3Index cell = geoToH3(from, res);
+    H3Index end = geoToH3(to, res);
+    if (cell == 0 || end == 0) {
+        return 0;
+    }
+    if (cellSetAdd(out, cell) < 0) {
+        return POLYLINE_ERR_MEMORY;
+    }
+
+    Vec3 a = geoToVec3(from);
+    Vec3 b = geoToVec3(to);
+    if (dot(a, b) < ANTIPODAL_DOT) {
+        return POLYLINE_ERR_UNDEFINED;
+    }
+    Vec3 d = {b.x - a.x, b.y - a.y, b.z - a.z};
+    double length = sqrt(dot(d, d));
+    if (length == 0) {
+        return 0;
+    }
+
+    // Bounds the number of cells visited, in case rounding near cell
+    // boundaries causes the same cells to be found repeatedly.
+    double spacing = edgeLengthKm(res) / GEO_EARTH_RADIUS_KM;
+    double maxSteps = 4 * ceil(GEO_PI * length / spacing) + 16;
+
+    double t = 0;
+    for (int steps = 0; cell != end && steps < maxSteps; steps++) {
+        double tExit = exitParam(cell, a, d, t);
+        if (tExit >= 1) {
+            break;
+        }
+
+        H3Index next = cell;
+        double step = WALK_STEP_RADS / length;
+        int probes = 0;
+        while (next == cell && probes < WALK_MAX_RETRIES) {
+            t = tExit + step < 1 ? tExit + step : 1;
+            GeoCoord geo = vec3ToGeo(along(a, d, t));
+            next = geoToH3(&geo, res);
+            step *= 4;
+            probes++;
+        }
+        if (next == cell || next == 0) {
+            break;
+        }
+
+        // A longer probe may have skipped over cells, so fill in any gap.
+        if (probes > 1 && !h3IndexesAreNeighbors(cell, next)) {
+            int err = addLine(cell, next, out);
+            if (err) {
+                return err;
+            }
+        }
+        cell = next;
+        if (cellSetAdd(out, cell) < 0) {
+            return POLYLINE_ERR_MEMORY;
+        }
+    }
+
+    // If rounding stopped the walk early, join the cell it reached to the
+    // cell containing the last point.
+    return cell == end ? 0 : addLine(cell, end, out);
+}
+
+/**
+ * Adds the cells along a segment which is straight in latitude and
+ * longitude, by splitting it into great circle arcs of at most densifyRads.
+ */
+static int walkDensifiedSegment(const GeoCoord *from, const GeoCoord *to,
+                                int res, double densifyRads, CellSet *out) {
+    double dLat = to->lat - from->lat;
+    double dLon = to->lon - from->lon;
+    // Take the shorter way around
+    if (dLon > GEO_PI) {
+        dLon -= GEO_2PI;
+    } else if (dLon < -GEO_PI) {
+        dLon += GEO_2PI;
+    }
+
+    double length = hypot(dLat, dLon * cos((from->lat + to->lat) / 2));
+    int numPieces = (int)ceil(length / densifyRads);
+    if (numPieces < 1) {
+        numPieces = 1;
+    }
+
+    GeoCoord previous = *from;
+    for (int i = 1; i <= numPieces; i++) {
+        GeoCoord next = {from->lat + dLat * i / numPieces,
+                         from->lon + dLon * i / numPieces};
+        int err = walkSegment(&previous, &next, res, out);
+        if (err) {
+            return err;
+        }
+        previous = next;
+    }
+    return 0;
+}
+
+int polylineToCells(const GeoCoord *verts, int numVerts, int res,
+                    double densifyRads, int k, CellSet *out) {
+    if (numVerts == 1) {
+        H3Index cell = geoToH3(&verts[0], res);
+        if (cell != 0 && cellSetAdd(out, cell) < 0) {
+            return POLYLINE_ERR_MEMORY;
+        }
+    }
+    for (int i = 0; i + 1 < numVerts; i++) {
+        int err = densifyRads > 0
+                      ? walkDensifiedSegment(&verts[i], &verts[i + 1], res,
+                                             densifyRads, out)
+                      : walkSegment(&verts[i], &verts[i + 1], res, out);
+        if (err) {
+            return err;
+        }
+    }
+
+    if (k > 0) {
+        H3Index *ring = malloc(maxKringSize(k) * sizeof(H3Index));
+        if (ring == NULL) {
+            return POLYLINE_ERR_MEMORY;
+        }
+        size_t pathSize = out->size;
+        for (size_t i = 0; i < pathSize; i++) {
+            int ringSize = maxKringSize(k);
+            for (int j = 0; j < ringSize; j++) {
+                ring[j] = 0;
+            }
+            kRing(out->cells[i], k, ring);
+            for (int j = 0; j < ringSize; j++) {
+                if (ring[j] != 0 && cellSetAdd(out, ring[j]) < 0) {
+                    free(ring);
+                    return POLYLINE_ERR_MEMORY;
+                }
+            }
+        }
+        free(ring);
+    }
+    return 0;
+}
+
+typedef struct {
+    const GeoCoord *verts;
+    const int *lineOffsets;
+    int res;
+    double densifyRads;
+    int k;
+    CellSet *results;
+} PolylineBatchContext;
+
+static int polylineBatchRange(void *context, size_t begin, size_t end) {
+    const PolylineBatchContext *ctx = (const PolylineBatchContext *)context;
+    for (size_t l = begin; l < end; l++) {
+        int first = ctx->lineOffsets[l];
+        int numVerts = ctx->lineOffsets[l + 1] - first;
+        if (cellSetInit(&ctx->results[l], numVerts)) {
+            return POLYLINE_ERR_MEMORY;
+        }
+        int err = polylineToCells(&ctx->verts[first], numVerts, ctx->res,
+                                  ctx->densifyRads, ctx->k, &ctx->results[l]);
+        if (err) {
+            return err;
+        }
+    }
+    return 0;
+}
+
+int polylineToCellsBatch(const GeoCoord *verts, const int *lineOffsets,
+                         int numLines, int res, double densifyRads, int k,
+                         int numThreads, CellSet *results) {
+    PolylineBatchContext context = {verts,       lineOffsets, res,
+                                    densifyRads, k,           results};
+    return parallelFor(numLines, numThreads, polylineBatchRange, &context);
+}
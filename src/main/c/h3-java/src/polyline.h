@@ -0,0 +1,63 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POLYLINE_H
+#define POLYLINE_H
+
+#include "cellSet.h"
+#include "h3api.h"
+
+/**
+ * Memory could not be allocated.
+ */
+#define POLYLINE_ERR_MEMORY 1
+
+/**
+ * The cells along a segment are not defined, because its ends are antipodal
+ * or the line between cells could not be found, such as across a pentagon.
+ */
+#define POLYLINE_ERR_UNDEFINED 2
+
+/**
+ * Adds every cell of the given resolution that the polyline passes through
+ * to `out`, in the order they are first visited. Each segment is a great
+ * circle arc between consecutive vertices (in radians).
+ *
+ * If densifyRads is positive, segments are instead treated as straight lines
+ * in latitude and longitude, approximated by great circle arcs no longer than
+ * densifyRads.
+ *
+ * If k is positive, the cells within k steps of the path are then added.
+ *
+ * Returns 0 on success, or POLYLINE_ERR_MEMORY or POLYLINE_ERR_UNDEFINED.
+ */
+int polylineToCells(const GeoCoord *verts, int numVerts, int res,
+                    double densifyRads, int k, CellSet *out);
+
+/**
+ * Rasterizes each polyline of a batch, using up to `numThreads` threads.
+ * Polyline l has the vertices verts[lineOffsets[l]] to
+ * verts[lineOffsets[l + 1] - 1], and its cells are placed in results[l],
+ * which must be zero initialized and destroyed by the caller with
+ * cellSetDestroy, even on failure.
+ *
+ * Returns 0 on success, or the first error of a polyline.
+ */
+int polylineToCellsBatch(const GeoCoord *verts, const int *lineOffsets,
+                         int numLines, int res, double densifyRads, int k,
+                         int numThreads, CellSet *results);
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "preparedPolygon.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "geoConstants.h"
+
+/**
+ * Upper bound on the number of latitude bands in a loop.
+ */
+#define MAX_BANDS (1 << 20)
+
+/**
+ * Average number of bands each edge may be listed in before the number of
+ * bands is reduced. This bounds the memory used for loops with many long
+ * north-south edges.
+ */
+#define MAX_BANDS_PER_EDGE 8
+
+/**
+ * Longitude normalization used by the core library's point in polygon test.
+ */
+#define NORMALIZE_LON(lon, isTransmeridian) \
+    ((isTransmeridian) && (lon) < 0 ? (lon) + GEO_2PI : (lon))
+
+static bool loopIsTransmeridian(const PreparedLoop *loop) {
+    return loop->east < loop->west;
+}
+
+/**
+ * Computes the bounding box of the loop, as bboxFromGeofence in the core
+ * library does.
+ */
+static void loopBBox(PreparedLoop *loop) {
+    if (loop->numVerts == 0) {
+        loop->north = loop->south = loop->east = loop->west = 0;
+        return;
+    }
+
+    loop->south = DBL_MAX;
+    loop->west = DBL_MAX;
+    loop->north = -DBL_MAX;
+    loop->east = -DBL_MAX;
+    double minPosLon = DBL_MAX;
+    double maxNegLon = -DBL_MAX;
+    bool isTransmeridian = false;
+
+    for (int i = 0; i < loop->numVerts; i++) {
+        const GeoCoord *coord = &loop->verts[i];
+        const GeoCoord *next = &loop->verts[(i + 1) % loop->numVerts];
+        if (coord->lat < loop->south) loop->south = coord->lat;
+        if (coord->lon < loop->west) loop->west = coord->lon;
+        if (coord->lat > loop->north) loop->north = coord->lat;
+        if (coord->lon > loop->east) loop->east = coord->lon;
+        if (coord->lon > 0 && coord->lon < minPosLon) minPosLon = coord->lon;
+        if (coord->lon < 0 && coord->lon > maxNegLon) maxNegLon = coord->lon;
+        if (fabs(coord->lon - next->lon) > GEO_PI) {
+            isTransmeridian = true;
+        }
+    }
+
+    if (isTransmeridian) {
+        loop->east = maxNegLon;
+        loop->west = minPosLon;
+    }
+}
+
+static bool loopBBoxContains(const PreparedLoop *loop, const GeoCoord *coord) {
+    return coord->lat >= loop->south && coord->lat <= loop->north &&
+           (loopIsTransmeridian(loop)
+                ? (coord->lon >= loop->west || coord->lon <= loop->east)
+                : (coord->lon >= loop->west && coord->lon <= loop->east));
+}
+
+/**
+ * Band containing the latitude. This is monotonic in lat, so an edge whose
+ * latitude range contains lat is always listed in this band.
+ */
+static int bandOf(const PreparedLoop *loop, double lat) {
+    if (loop->bandHeight <= 0) {
+        return 0;
+    }
+    double band = (lat - loop->south) / loop->bandHeight;
+    if (!(band >= 0)) {
+        return 0;
+    }
+    if (band >= loop->numBands - 1) {
+        return loop->numBands - 1;
+    }
+    return (int)band;
+}
+
+static void edgeBands(const PreparedLoop *loop, int edge, int *first,
+                      int *last) {
+    double aLat = loop->verts[edge].lat;
+    double bLat = loop->verts[(edge + 1) % loop->numVerts].lat;
+    *first = bandOf(loop, aLat < bLat ? aLat : bLat);
+    *last = bandOf(loop, aLat < bLat ? bLat : aLat);
+}
+
+static void setNumBands(PreparedLoop *loop, int numBands) {
+    loop->numBands = numBands;
+    loop->bandHeight = (loop->north - loop->south) / numBands;
+}
+
+/**
+ * Number of band entries needed with the loop's current number of bands.
+ */
+static size_t countBandEntries(const PreparedLoop *loop) {
+    size_t entries = 0;
+    for (int i = 0; i < loop->numVerts; i++) {
+        int first, last;
+        edgeBands(loop, i, &first, &last);
+        entries += last - first + 1;
+    }
+    return entries;
+}
+
+static void destroyLoop(PreparedLoop *loop) {
+    free(loop->verts);
+    free(loop->bandOffsets);
+    free(loop->bandEdges);
+    loop->verts = NULL;
+    loop->bandOffsets = NULL;
+    loop->bandEdges = NULL;
+}
+
+static int createLoop(const Geofence *geofence, PreparedLoop *loop) {
+    memset(loop, 0, sizeof(PreparedLoop));
+    loop->numVerts = geofence->numVerts;
+    loop->verts = malloc((geofence->numVerts + 1) * sizeof(GeoCoord));
+    if (loop->verts == NULL) {
+        return 1;
+    }
+    memcpy(loop->verts, geofence->verts, geofence->numVerts * sizeof(GeoCoord));
+    loopBBox(loop);
+
+    int numBands = loop->numVerts < MAX_BANDS ? loop->numVerts : MAX_BANDS;
+    if (numBands < 1) {
+        numBands = 1;
+    }
+    setNumBands(loop, numBands);
+    size_t maxEntries = (size_t)loop->numVerts * MAX_BANDS_PER_EDGE;
+    size_t numEntries = countBandEntries(loop);
+    while (numEntries > maxEntries && loop->numBands > 1) {
+        setNumBands(loop, loop->numBands / 2);
+        numEntries = countBandEntries(loop);
+    }
+
+    loop->bandOffsets = calloc(loop->numBands + 1, sizeof(int));
+    loop->bandEdges = malloc((numEntries + 1) * sizeof(int));
+    if (loop->bandOffsets == NULL || loop->bandEdges == NULL) {
+        destroyLoop(loop);
+        return 1;
+    }
+
+    // Counting sort of the edges by band. Edges are visited in order, so each
+    // band lists its edges in the order the core library visits them.
+    for (int i = 0; i < loop->numVerts; i++) {
+        int first, last;
+        edgeBands(loop, i, &first, &last);
+        for (int b = first; b <= last; b++) {
+            loop->bandOffsets[b + 1]++;
+        }
+    }
+    for (int b = 0; b < loop->numBands; b++) {
+        loop->bandOffsets[b + 1] += loop->bandOffsets[b];
+    }
+    int *next = malloc(loop->numBands * sizeof(int));
+    if (next == NULL) {
+        destroyLoop(loop);
+        return 1;
+    }
+    memcpy(next, loop->bandOffsets, loop->numBands * sizeof(int));
+    for (int i = 0; i < loop->numVerts; i++) {
+        int first, last;
+        edgeBands(loop, i, &first, &last);
+        for (int b = first; b <= last; b++) {
+            loop->bandEdges[next[b]++] = i;
+        }
+    }
+    free(next);
+    return 0;
+}
+
+/**
+ * Ray casting test, identical to pointInsideGeofence in the core library
+ * except that only the edges in the point's band are visited. Edges outside
+ * the band cannot span the point's latitude, so they would be skipped anyway.
+ */
+static bool loopContains(const PreparedLoop *loop, const GeoCoord *coord) {
+    if (loop->numVerts == 0 || !loopBBoxContains(loop, coord)) {
+        return false;
+    }
+
+    bool isTransmeridian = loopIsTransmeridian(loop);
+    bool contains = false;
+
+    double lat = coord->lat;
+    double lng = NORMALIZE_LON(coord->lon, isTransmeridian);
+
+    int band = bandOf(loop, lat);
+    for (int k = loop->bandOffsets[band]; k < loop->bandOffsets[band + 1];
+         k++) {
+        int edge = loop->bandEdges[k];
+        GeoCoord a = loop->verts[edge];
+        GeoCoord b = loop->verts[(edge + 1) % loop->numVerts];
+        if (a.lat > b.lat) {
+            GeoCoord tmp = a;
+            a = b;
+            b = tmp;
+        }
+
+        if (lat < a.lat || lat > b.lat) {
+            continue;
+        }
+
+        double aLng = NORMALIZE_LON(a.lon, isTransmeridian);
+        double bLng = NORMALIZE_LON(b.lon, isTransmeridian);
+
+        // Ties are broken to the west, as in the core library
+        if (aLng == lng || bLng == lng) {
+            lng -= DBL_EPSILON;
+        }
+
+        double ratio = (lat - a.lat) / (b.lat - a.lat);
+        double testLng =
+            NORMALIZE_LON(aLng + (bLng - aLng) * ratio, isTransmeridian);
+
+        if (testLng > lng) {
+            contains = !contains;
+        }
+    }
+
+    return contains;
+}
+
+int preparedPolygonCreate(const GeoPolygon *polygon, PreparedPolygon *out) {
+    memset(out, 0, sizeof(PreparedPolygon));
+    if (createLoop(&polygon->geofence, &out->outer)) {
+        return 1;
+    }
+
+    if (polygon->numHoles > 0) {
+        out->holes = calloc(polygon->numHoles, sizeof(PreparedLoop));
+        if (out->holes == NULL) {
+            preparedPolygonDestroy(out);
+            return 1;
+        }
+    }
+    for (int i = 0; i < polygon->numHoles; i++) {
+        if (createLoop(&polygon->holes[i], &out->holes[i])) {
+            preparedPolygonDestroy(out);
+            return 1;
+        }
+        out->numHoles++;
+    }
+    return 0;
+}
+
+void preparedPolygonDestroy(PreparedPolygon *polygon) {
+    destroyLoop(&polygon->outer);
+    for (int i = 0; i < polygon->numHoles; i++) {
+        destroyLoop(&polygon->holes[i]);
+    }
+    free(polygon->holes);
+    polygon->holes = NULL;
+    polygon->numHoles = 0;
+}
+
+bool preparedPolygonContains(const PreparedPolygon *polygon,
+                             const GeoCoord *coord) {
+    if (!loopContains(&polygon->outer, coord)) {
+        return false;
+    }
+    for (int i = 0; i < polygon->numHoles; i++) {
+        if (loopContains(&polygon->holes[i], coord)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREPAREDPOLYGON_H
+#define PREPAREDPOLYGON_H
+
+#include <stdbool.h>
+
+#include "h3api.h"
+
+/**
+ * A loop of a polygon, with its edges indexed by latitude band.
+ *
+ * Edge i runs from verts[i] to verts[(i + 1) % numVerts]. The edges that
+ * overlap band b are bandEdges[bandOffsets[b]] to
+ * bandEdges[bandOffsets[b + 1] - 1], in increasing order.
+ */
+typedef struct {
+    int numVerts;
+    GeoCoord *verts;
+    // Bounding box, computed as in the core library. If the loop crosses the
+    // antimeridian, east < west.
+    double north;
+    double south;
+    double east;
+    double west;
+    int numBands;
+    double bandHeight;
+    int *bandOffsets;
+    int *bandEdges;
+} PreparedLoop;
+
+/**
+ * A polygon prepared for repeated point in polygon tests.
+ */
+typedef struct {
+    PreparedLoop outer;
+    int numHoles;
+    PreparedLoop *holes;
+} PreparedPolygon;
+
+/**
+ * Copies and indexes the polygon.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated. On
+ * failure nothing needs to be destroyed.
+ */
+int preparedPolygonCreate(const GeoPolygon *polygon, PreparedPolygon *out);
+
+/**
+ * Frees the memory held by the prepared polygon.
+ */
+void preparedPolygonDestroy(PreparedPolygon *polygon);
+
+/**
+ * Returns true if the coordinate (in radians) is inside the polygon.
+ *
+ * This gives the same result as the ray casting used by the core library's
+ * polyfill, but only tests the edges in the coordinate's latitude band.
+ */
+bool preparedPolygonContains(const PreparedPolygon *polygon,
+                             const GeoCoord *coord);
+
+#endif
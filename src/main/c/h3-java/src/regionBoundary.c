@@ -0,0 +1,57 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "regionBoundary.h"
+
+/**
+ * Maximum number of edges of a cell.
+ */
+#define MAX_CELL_EDGES 6
+
+int regionBoundary(const H3Index *cells, size_t numCells, CellSet *edges,
+                   CellSet *boundaryCells, CellSet *exteriorCells) {
+    CellSet region;
+    if (cellSetInit(&region, numCells)) {
+        return 1;
+    }
+
+    int err = 0;
+    for (size_t i = 0; i < numCells && !err; i++) {
+        err = h3IsValid(cells[i]) && cellSetAdd(&region, cells[i]) < 0;
+    }
+
+    for (size_t i = 0; i < region.size && !err; i++) {
+        H3Index cellEdges[MAX_CELL_EDGES] = {0};
+        getH3UnidirectionalEdgesFromHexagon(region.cells[i], cellEdges);
+        for (int j = 0; j < MAX_CELL_EDGES && !err; j++) {
+            // Pentagons have only 5 edges
+            if (cellEdges[j] == 0) {
+                continue;
+            }
+            H3Index neighbor =
+                getDestinationH3IndexFromUnidirectionalEdge(cellEdges[j]);
+            if (cellSetContains(&region, neighbor)) {
+                continue;
+            }
+            err = cellSetAdd(edges, cellEdges[j]) < 0 ||
+                  cellSetAdd(boundaryCells, region.cells[i]) < 0 ||
+                  cellSetAdd(exteriorCells, neighbor) < 0;
+        }
+    }
+
+    cellSetDestroy(&region);
+    return err;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REGIONBOUNDARY_H
+#define REGIONBOUNDARY_H
+
+#include <stddef.h>
+
+#include "cellSet.h"
+#include "h3api.h"
+
+/**
+ * Finds the boundary of a set of cells of one resolution:
+ *
+ * - `edges`: unidirectional edges from a cell in the set to one outside it,
+ * - `boundaryCells`: cells in the set with a neighbor outside it,
+ * - `exteriorCells`: cells outside the set with a neighbor in it.
+ *
+ * Each is in the order found, visiting the input cells in order. Invalid
+ * cells in the input are ignored. The output sets must be initialized, and
+ * are destroyed by the caller.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated.
+ */
+int regionBoundary(const H3Index *cells, size_t numCells, CellSet *edges,
+                   CellSet *boundaryCells, CellSet *exteriorCells);
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simplify.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "coordMap.h"
+#include "geoConstants.h"
+
+/**
+ * Difference in longitude from a to b, taking the shorter way around.
+ */
+static double lonDelta(double a, double b) {
+    double delta = b - a;
+    if (delta > GEO_PI) {
+        delta -= GEO_2PI;
+    } else if (delta < -GEO_PI) {
+        delta += GEO_2PI;
+    }
+    return delta;
+}
+
+/**
+ * Distance, in radians, from p to the segment from a to b.
+ */
+static double segmentDistance(const GeoCoord *p, const GeoCoord *a,
+                              const GeoCoord *b) {
+    double cosLat = cos((a->lat + b->lat) / 2);
+    double bx = lonDelta(a->lon, b->lon) * cosLat;
+    double by = b->lat - a->lat;
+    double px = lonDelta(a->lon, p->lon) * cosLat;
+    double py = p->lat - a->lat;
+
+    double lengthSquared = bx * bx + by * by;
+    double t = lengthSquared > 0 ? (px * bx + py * by) / lengthSquared : 0;
+    if (t < 0) {
+        t = 0;
+    } else if (t > 1) {
+        t = 1;
+    }
+    return hypot(px - t * bx, py - t * by);
+}
+
+typedef struct {
+    int first;
+    int last;
+} Range;
+
+/**
+ * Marks the vertices to keep between the vertices first and last, which are
+ * kept. Indexes past the end of the loop wrap around. `stack` must have room
+ * for numVerts ranges.
+ */
+static void douglasPeucker(const GeoCoord *verts, int numVerts, int first,
+                           int last, double toleranceRads, bool *keep,
+                           Range *stack) {
+    int stackSize = 0;
+    stack[stackSize++] = (Range){first, last};
+    while (stackSize > 0) {
+        Range range = stack[--stackSize];
+        const GeoCoord *a = &verts[range.first % numVerts];
+        const GeoCoord *b = &verts[range.last % numVerts];
+
+        int farthest = -1;
+        double farthestDistance = toleranceRads;
+        for (int i = range.first + 1; i < range.last; i++) {
+            double distance = segmentDistance(&verts[i % numVerts], a, b);
+            if (distance > farthestDistance) {
+                farthest = i;
+                farthestDistance = distance;
+            }
+        }
+
+        if (farthest >= 0) {
+            keep[farthest % numVerts] = true;
+            stack[stackSize++] = (Range){range.first, farthest};
+            stack[stackSize++] = (Range){farthest, range.last};
+        }
+    }
+}
+
+/**
+ * Index of the vertex farthest from vertex `from`.
+ */
+static int farthestVertex(const GeoCoord *verts, int numVerts, int from) {
+    int farthest = from;
+    double farthestDistance = -1;
+    for (int i = 0; i < numVerts; i++) {
+        double distance =
+            segmentDistance(&verts[i], &verts[from], &verts[from]);
+        if (distance > farthestDistance) {
+            farthest = i;
+            farthestDistance = distance;
+        }
+    }
+    return farthest;
+}
+
+/**
+ * Marks the vertices of a loop to keep. Vertices already marked in `keep`
+ * are kept, and the loop is simplified between them.
+ */
+static void simplifyLoop(const GeoCoord *verts, int numVerts,
+                         double toleranceRads, bool *keep, Range *stack) {
+    int firstKept = -1;
+    int numKept = 0;
+    for (int i = 0; i < numVerts; i++) {
+        if (keep[i]) {
+            if (firstKept < 0) {
+                firstKept = i;
+            }
+            numKept++;
+        }
+    }
+    // A loop needs at least two fixed vertices to be split into lines
+    if (firstKept < 0) {
+        firstKept = 0;
+        keep[0] = true;
+        numKept++;
+    }
+    if (numKept == 1) {
+        keep[farthestVertex(verts, numVerts, firstKept)] = true;
+    }
+
+    int previous = firstKept;
+    for (int i = firstKept + 1; i <= firstKept + numVerts; i++) {
+        if (keep[i % numVerts]) {
+            douglasPeucker(verts, numVerts, previous, i, toleranceRads, keep,
+                           stack);
+            previous = i;
+        }
+    }
+}
+
+static int loopSize(const LinkedGeoLoop *loop) {
+    int size = 0;
+    for (LinkedGeoCoord *coord = loop->first; coord != NULL;
+         coord = coord->next) {
+        size++;
+    }
+    return size;
+}
+
+/**
+ * Removes the vertices of the loop which are not marked to keep, unless
+ * fewer than three would remain.
+ */
+static void removeVertices(LinkedGeoLoop *loop, const bool *keep,
+                           int numVerts) {
+    int numKept = 0;
+    for (int i = 0; i < numVerts; i++) {
+        numKept += keep[i];
+    }
+    if (numKept < 3) {
+        return;
+    }
+
+    LinkedGeoCoord *previous = NULL;
+    LinkedGeoCoord *coord = loop->first;
+    for (int i = 0; i < numVerts; i++) {
+        LinkedGeoCoord *next = coord->next;
+        if (keep[i]) {
+            if (previous == NULL) {
+                loop->first = coord;
+            } else {
+                previous->next = coord;
+            }
+            previous = coord;
+        } else {
+            free(coord);
+        }
+        coord = next;
+    }
+    previous->next = NULL;
+    loop->last = previous;
+}
+
+/**
+ * Counts how many times each vertex appears in the polygons, and finds the
+ * size of the largest loop. counts[id] is the count of the vertex with the
+ * id in `coords`.
+ */
+static int countVertices(const LinkedGeoPolygon *polygon, CoordMap *coords,
+                         int **counts, int *maxLoopSize) {
+    size_t numCounts = 0;
+    for (const LinkedGeoPolygon *p = polygon; p != NULL; p = p->next) {
+        for (LinkedGeoLoop *loop = p->first; loop != NULL; loop = loop->next) {
+            int size = loopSize(loop);
+            if (size > *maxLoopSize) {
+                *maxLoopSize = size;
+            }
+
+            for (LinkedGeoCoord *coord = loop->first; coord != NULL;
+                 coord = coord->next) {
+                size_t id;
+                if (coordMapAdd(coords, &coord->vertex, &id)) {
+                    return 1;
+                }
+                if (id >= numCounts) {
+                    size_t newNumCounts = coords->capacity;
+                    int *newCounts =
+                        realloc(*counts, newNumCounts * sizeof(int));
+                    if (newCounts == NULL) {
+                        return 1;
+                    }
+                    for (size_t i = numCounts; i < newNumCounts; i++) {
+                        newCounts[i] = 0;
+                    }
+                    *counts = newCounts;
+                    numCounts = newNumCounts;
+                }
+                (*counts)[id]++;
+            }
+        }
+    }
+    return 0;
+}
+
+int simplifyLinkedGeo(LinkedGeoPolygon *polygon, double toleranceRads) {
+    CoordMap coords;
+    if (coordMapInit(&coords, 0)) {
+        return 1;
+    }
+    int *counts = NULL;
+    int maxLoopSize = 0;
+    int err = countVertices(polygon, &coords, &counts, &maxLoopSize);
+
+    GeoCoord *verts = malloc(maxLoopSize * sizeof(GeoCoord));
+    bool *keep = malloc(maxLoopSize * sizeof(bool));
+    Range *stack = malloc(maxLoopSize * sizeof(Range));
+    if (maxLoopSize > 0 && (verts == NULL || keep == NULL || stack == NULL)) {
+        err = 1;
+    }
+
+    for (LinkedGeoPolygon *p = polygon; p != NULL && !err; p = p->next) {
+        for (LinkedGeoLoop *loop = p->first; loop != NULL; loop = loop->next) {
+            int numVerts = 0;
+            for (LinkedGeoCoord *coord = loop->first; coord != NULL;
+                 coord = coord->next) {
+                size_t id;
+                // Already present, so this does not allocate
+                coordMapAdd(&coords, &coord->vertex, &id);
+                verts[numVerts] = coord->vertex;
+                keep[numVerts] = counts[id] > 1;
+                numVerts++;
+            }
+            if (numVerts > 3) {
+                simplifyLoop(verts, numVerts, toleranceRads, keep, stack);
+                removeVertices(loop, keep, numVerts);
+            }
+        }
+    }
+
+    free(stack);
+    free(keep);
+    free(verts);
+    free(counts);
+    coordMapDestroy(&coords);
+    return err;
+}
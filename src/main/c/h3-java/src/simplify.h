@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPLIFY_H
+#define SIMPLIFY_H
+
+#include "h3api.h"
+
+/**
+ * Simplifies the loops of the polygons in place with the Douglas-Peucker
+ * algorithm, removing vertices which are within `toleranceRads` of the
+ * simplified line. Distances are measured in a local equirectangular
+ * projection.
+ *
+ * Vertices which appear more than once, where loops or polygons touch, are
+ * always kept, so loops which touch before simplification still touch at
+ * the same points after. Loops which would be left with fewer than three
+ * vertices are not simplified.
+ *
+ * Returns 0 on success, or nonzero if memory could not be allocated, in
+ * which case some loops may have been simplified.
+ */
+int simplifyLinkedGeo(LinkedGeoPolygon *polygon, double toleranceRads);
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef VEC3_H
+#define VEC3_H
+
+#include <math.h>
+
+#include "h3api.h"
+
+/**
+ * A point or direction in 3D, with points on the sphere of unit radius.
+ */
+typedef struct {
+    double x;
+    double y;
+    double z;
+} Vec3;
+
+static inline Vec3 geoToVec3(const GeoCoord *geo) {
+    double cosLat = cos(geo->lat);
+    Vec3 v = {cosLat * cos(geo->lon), cosLat * sin(geo->lon), sin(geo->lat)};
+    return v;
+}
+
+static inline GeoCoord vec3ToGeo(Vec3 v) {
+    GeoCoord geo = {atan2(v.z, sqrt(v.x * v.x + v.y * v.y)), atan2(v.y, v.x)};
+    return geo;
+}
+
+static inline Vec3 cross(Vec3 a, Vec3 b) {
+    Vec3 v = {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+              a.x * b.y - a.y * b.x};
+    return v;
+}
+
+static inline double dot(Vec3 a, Vec3 b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+#endif
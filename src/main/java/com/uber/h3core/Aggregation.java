@@ -0,0 +1,40 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.uber.h3core;
+
+/**
+ * How the values of child indexes are combined into the value of their parent.
+ */
+public enum Aggregation {
+    /**
+     * Sum of the values
+     */
+    sum,
+    /**
+     * Smallest value
+     */
+    min,
+    /**
+     * Largest value
+     */
+    max,
+    /**
+     * Mean of the values of the finest indexes under the parent, so each of those
+     * is weighted equally
+     */
+    mean
+}
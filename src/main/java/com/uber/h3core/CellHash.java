@@ -0,0 +1,39 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+/**
+ * Hashing of indexes for open addressing tables.
+ */
+final class CellHash {
+    private CellHash() {
+        // Static methods only
+    }
+
+    /**
+     * Mixes all bits of the index into the low bits. Nearby indexes differ only in their
+     * last digits, and the unused digits are all set, so tables cannot use the low bits
+     * of an index directly. This is the finalizer of MurmurHash3.
+     */
+    static long mix(long h3) {
+        h3 ^= h3 >>> 33;
+        h3 *= 0xff51afd7ed558ccdL;
+        h3 ^= h3 >>> 33;
+        h3 *= 0xc4ceb9fe1a85ec53L;
+        h3 ^= h3 >>> 33;
+        return h3;
+    }
+}
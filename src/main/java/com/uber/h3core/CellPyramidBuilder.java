@@ -0,0 +1,254 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.uber.h3core;
+
+import com.uber.h3core.util.CellPyramid;
+
+import java.util.Arrays;
+import java.util.stream.IntStream;
+
+/**
+ * Builds a {@link CellPyramid} in one pass from the finest resolution to the coarsest.
+ *
+ * <p>Each level is kept sorted, so the children of each parent are next to each other
+ * and each level is found by grouping runs of the level below it.
+ */
+final class CellPyramidBuilder {
+    /**
+     * Number of children of a hexagon, one resolution finer.
+     */
+    private static final int NUM_CHILDREN = 7;
+
+    private final H3Core h3;
+    private final Aggregation aggregation;
+    private final int minRes;
+    private final int maxRes;
+
+    // Each of these is indexed by resolution, and then by position in the level.
+    private final long[][] cells;
+    private final double[][] values;
+    private final int[][] counts;
+    /**
+     * Finest resolution at which all of the descendants of the cell are in their level.
+     */
+    private final int[][] completeRes;
+    /**
+     * Position of the parent of the cell in the level one resolution coarser.
+     */
+    private final int[][] parents;
+
+    private CellPyramidBuilder(H3Core h3, Aggregation aggregation, int minRes, int maxRes) {
+        this.h3 = h3;
+        this.aggregation = aggregation;
+        this.minRes = minRes;
+        this.maxRes = maxRes;
+        cells = new long[maxRes + 1][];
+        values = new double[maxRes + 1][];
+        counts = new int[maxRes + 1][];
+        completeRes = new int[maxRes + 1][];
+        parents = new int[maxRes + 1][];
+    }
+
+    static CellPyramid build(H3Core h3, long[] cells, double[] values, int minRes, Aggregation aggregation) {
+        if (cells.length != values.length) {
+            throw new IllegalArgumentException("cells and values must have the same length");
+        }
+        H3Core.checkResolution(minRes);
+        int maxRes = cells.length > 0 ? h3.h3GetResolution(cells[0]) : minRes;
+        for (long cell : cells) {
+            if (h3.h3GetResolution(cell) != maxRes) {
+                throw new IllegalArgumentException("Indexes must all be of the same resolution");
+            }
+        }
+        if (minRes > maxRes) {
+            throw new IllegalArgumentException(
+                    String.format("minRes (%d) must be at most the resolution of the indexes (%d)", minRes, maxRes));
+        }
+
+        CellPyramidBuilder builder = new CellPyramidBuilder(h3, aggregation, minRes, maxRes);
+        builder.buildFinest(cells, values);
+        for (int res = maxRes - 1; res >= minRes; res--) {
+            builder.buildParents(res);
+        }
+        return builder.toPyramid();
+    }
+
+    /**
+     * Sorts the input into the finest level, combining duplicates.
+     */
+    private void buildFinest(long[] inputCells, double[] inputValues) {
+        int[] order = isSorted(inputCells)
+                ? IntStream.range(0, inputCells.length).toArray()
+                : IndexSort.sortedOrder(inputCells);
+
+        long[] levelCells = new long[inputCells.length];
+        double[] levelValues = new double[inputCells.length];
+        int[] levelCounts = new int[inputCells.length];
+        int size = 0;
+        for (int i : order) {
+            if (size > 0 && levelCells[size - 1] == inputCells[i]) {
+                levelValues[size - 1] = combine(levelValues[size - 1], inputValues[i]);
+                levelCounts[size - 1]++;
+            } else {
+                levelCells[size] = inputCells[i];
+                levelValues[size] = inputValues[i];
+                levelCounts[size] = 1;
+                size++;
+            }
+        }
+
+        cells[maxRes] = Arrays.copyOf(levelCells, size);
+        values[maxRes] = Arrays.copyOf(levelValues, size);
+        counts[maxRes] = Arrays.copyOf(levelCounts, size);
+        completeRes[maxRes] = new int[size];
+        Arrays.fill(completeRes[maxRes], maxRes);
+    }
+
+    /**
+     * Builds the level of the given resolution from the level one resolution finer.
+     */
+    private void buildParents(int res) {
+        long[] children = cells[res + 1];
+        long[] childParentCells = new long[children.length];
+        for (int i = 0; i < children.length; i++) {
+            childParentCells[i] = h3.h3ToParent(children[i], res);
+        }
+        int[] childParents = new int[children.length];
+        long[] levelCells = new long[children.length];
+        double[] levelValues = new double[children.length];
+        int[] levelCounts = new int[children.length];
+        int[] levelComplete = new int[children.length];
+
+        int size = 0;
+        for (int start = 0; start < children.length; ) {
+            // Children of the same parent are next to each other, as they differ only in
+            // the digit for their resolution.
+            long parent = childParentCells[start];
+            double value = values[res + 1][start];
+            int count = 0;
+            int complete = maxRes;
+            int end = start;
+            for (; end < children.length && childParentCells[end] == parent; end++) {
+                if (end > start) {
+                    value = combine(value, values[res + 1][end]);
+                }
+                count += counts[res + 1][end];
+                complete = Math.min(complete, completeRes[res + 1][end]);
+                childParents[end] = size;
+            }
+
+            int numChildren = end - start;
+            boolean allChildren = numChildren == NUM_CHILDREN
+                    || (numChildren == NUM_CHILDREN - 1 && h3.h3IsPentagon(parent));
+            levelCells[size] = parent;
+            levelValues[size] = value;
+            levelCounts[size] = count;
+            levelComplete[size] = allChildren ? complete : res;
+            size++;
+            start = end;
+        }
+
+        parents[res + 1] = childParents;
+        cells[res] = Arrays.copyOf(levelCells, size);
+        values[res] = Arrays.copyOf(levelValues, size);
+        counts[res] = Arrays.copyOf(levelCounts, size);
+        completeRes[res] = Arrays.copyOf(levelComplete, size);
+    }
+
+    private double combine(double a, double b) {
+        switch (aggregation) {
+            case min:
+                return Math.min(a, b);
+            case max:
+                return Math.max(a, b);
+            default:
+                // Means are divided by the counts once all levels are built
+                return a + b;
+        }
+    }
+
+    private CellPyramid toPyramid() {
+        int numLevels = maxRes - minRes + 1;
+        int[] levelOffsets = new int[numLevels + 1];
+        for (int res = minRes; res <= maxRes; res++) {
+            levelOffsets[res - minRes + 1] = levelOffsets[res - minRes] + cells[res].length;
+        }
+
+        int total = levelOffsets[numLevels];
+        long[] allCells = new long[total];
+        double[] allValues = new double[total];
+        int[] allCounts = new int[total];
+        for (int res = minRes; res <= maxRes; res++) {
+            int offset = levelOffsets[res - minRes];
+            System.arraycopy(cells[res], 0, allCells, offset, cells[res].length);
+            System.arraycopy(values[res], 0, allValues, offset, values[res].length);
+            System.arraycopy(counts[res], 0, allCounts, offset, counts[res].length);
+        }
+        if (aggregation == Aggregation.mean) {
+            for (int i = 0; i < total; i++) {
+                allValues[i] /= allCounts[i];
+            }
+        }
+
+        // Each cell is in the coverage of a contiguous range of levels, so the coverage of
+        // every level is found in one pass over the cells, counting and then placing them.
+        int[] coverageOffsets = new int[numLevels + 1];
+        for (int r = maxRes; r >= minRes; r--) {
+            for (int i = 0; i < cells[r].length; i++) {
+                for (int level = coverageStart(r, i); level <= completeRes[r][i]; level++) {
+                    coverageOffsets[level - minRes + 1]++;
+                }
+            }
+        }
+        for (int level = 0; level < numLevels; level++) {
+            coverageOffsets[level + 1] += coverageOffsets[level];
+        }
+        long[] coverage = new long[coverageOffsets[numLevels]];
+        int[] next = Arrays.copyOf(coverageOffsets, numLevels);
+        for (int r = maxRes; r >= minRes; r--) {
+            for (int i = 0; i < cells[r].length; i++) {
+                for (int level = coverageStart(r, i); level <= completeRes[r][i]; level++) {
+                    coverage[next[level - minRes]++] = cells[r][i];
+                }
+            }
+        }
+        for (int level = 0; level < numLevels; level++) {
+            Arrays.sort(coverage, coverageOffsets[level], coverageOffsets[level + 1]);
+        }
+
+        return new CellPyramid(minRes, maxRes, allCells, allValues, allCounts, levelOffsets,
+                coverage, coverageOffsets);
+    }
+
+    /**
+     * Returns the resolution of the first level whose compacted coverage, the coarsest cells
+     * all of whose descendants at that resolution are in the level, includes the cell. It
+     * is included up to its complete resolution; before this, its parent is included.
+     */
+    private int coverageStart(int res, int i) {
+        return res > minRes ? Math.max(res, completeRes[res - 1][parents[res][i]] + 1) : res;
+    }
+
+    private static boolean isSorted(long[] cells) {
+        for (int i = 1; i < cells.length; i++) {
+            if (cells[i] < cells[i - 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
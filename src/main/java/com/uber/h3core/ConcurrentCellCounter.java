@@ -0,0 +1,241 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.util.CellCounts;
+
+import java.util.Arrays;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLongArray;
+
+/**
+ * Counts per index, which many threads can update at once without locking or
+ * allocating.
+ *
+ * <p>Indexes are kept as primitive keys in an open addressing table of fixed capacity.
+ * Each slot's count is split across a number of stripes, each in its own array, and a
+ * thread adds to the stripe chosen by its ID, so threads updating a popular index
+ * usually do not write to the same cache line. Each slot takes <code>8 * (1 + numStripes)</code>
+ * bytes, and there are between 1.33 and 2.67 slots per index the counter is sized for.
+ *
+ * <p>Once added, an index keeps its slot, even if its count is decayed to zero, so the
+ * counter should be sized for all the indexes it will see. Reads are not atomic across
+ * indexes: a snapshot taken while counts are updated may include some updates and not
+ * others.
+ */
+public final class ConcurrentCellCounter {
+    /**
+     * Largest fraction of the slots which may be used, so probe sequences stay short.
+     */
+    private static final double MAX_LOAD = 0.75;
+    private static final int MAX_STRIPES = 8;
+
+    private final AtomicLongArray keys;
+    private final AtomicLongArray[] stripes;
+    private final int mask;
+    private final int maxSize;
+    private final AtomicInteger size = new AtomicInteger();
+
+    /**
+     * Creates a counter for up to <code>maxCells</code> indexes, with a stripe for each
+     * available processor, up to 8.
+     */
+    public ConcurrentCellCounter(int maxCells) {
+        this(maxCells, Math.min(MAX_STRIPES, Runtime.getRuntime().availableProcessors()));
+    }
+
+    /**
+     * Creates a counter for up to <code>maxCells</code> indexes.
+     *
+     * @param maxCells Number of distinct indexes which may be added
+     * @param numStripes Number of stripes each count is split across, rounded up to a power of two
+     * @throws IllegalArgumentException maxCells is negative or too large, or numStripes is
+     *                                  less than 1
+     */
+    public ConcurrentCellCounter(int maxCells, int numStripes) {
+        if (maxCells < 0 || maxCells > (1 << 28)) {
+            throw new IllegalArgumentException(String.format("maxCells (%d) is out of range", maxCells));
+        }
+        if (numStripes < 1) {
+            throw new IllegalArgumentException("numStripes must be at least 1");
+        }
+        int capacity = Integer.highestOneBit(Math.max(2, (int) Math.ceil(maxCells / MAX_LOAD)) * 2 - 1);
+        this.keys = new AtomicLongArray(capacity);
+        this.mask = capacity - 1;
+        this.maxSize = (int) (capacity * MAX_LOAD);
+        this.stripes = new AtomicLongArray[Integer.highestOneBit(numStripes * 2 - 1)];
+        for (int i = 0; i < stripes.length; i++) {
+            stripes[i] = new AtomicLongArray(capacity);
+        }
+    }
+
+    /**
+     * Adds one to the count of the index.
+     *
+     * @throws IllegalArgumentException The index is 0
+     * @throws IllegalStateException The counter is full
+     */
+    public void increment(long h3) {
+        add(h3, 1);
+    }
+
+    /**
+     * Adds <code>delta</code> to the count of the index.
+     *
+     * @throws IllegalArgumentException The index is 0
+     * @throws IllegalStateException The counter is full
+     */
+    public void add(long h3, long delta) {
+        int slot = insert(h3);
+        stripes[(int) CellHash.mix(Thread.currentThread().getId()) & (stripes.length - 1)].getAndAdd(slot, delta);
+    }
+
+    /**
+     * Returns the count of the index, or 0 if it has not been added.
+     */
+    public long get(long h3) {
+        int slot = find(h3);
+        return slot < 0 ? 0 : count(slot);
+    }
+
+    /**
+     * Number of distinct indexes added. While indexes are being added, this may include
+     * some which are not yet visible.
+     */
+    public int size() {
+        return size.get();
+    }
+
+    /**
+     * Multiplies every count by <code>factor</code>, rounding towards zero, for example
+     * to exponentially decay counts over time. Each stripe is rounded separately.
+     *
+     * @throws IllegalArgumentException factor is not between 0 and 1
+     */
+    public void decay(double factor) {
+        if (!(factor >= 0 && factor <= 1)) {
+            throw new IllegalArgumentException("factor must be between 0 and 1");
+        }
+        for (AtomicLongArray stripe : stripes) {
+            for (int slot = 0; slot <= mask; slot++) {
+                if (stripe.get(slot) != 0) {
+                    stripe.getAndUpdate(slot, count -> (long) (count * factor));
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the indexes with nonzero counts, sorted, and their counts.
+     */
+    public CellCounts snapshot() {
+        long[] cells = new long[size()];
+        int numCells = 0;
+        for (int slot = 0; slot <= mask && numCells < cells.length; slot++) {
+            long key = keys.get(slot);
+            if (key != 0) {
+                cells[numCells++] = key;
+            }
+        }
+        Arrays.sort(cells, 0, numCells);
+
+        long[] counts = new long[numCells];
+        int numNonZero = 0;
+        for (int i = 0; i < numCells; i++) {
+            long count = count(find(cells[i]));
+            if (count != 0) {
+                cells[numNonZero] = cells[i];
+                counts[numNonZero++] = count;
+            }
+        }
+        return new CellCounts(Arrays.copyOf(cells, numNonZero), Arrays.copyOf(counts, numNonZero));
+    }
+
+    /**
+     * Returns the counts summed to the parents of the indexes at <code>res</code>. Indexes
+     * coarser than <code>res</code> are not included.
+     *
+     * @throws IllegalArgumentException Invalid resolution
+     */
+    public CellCounts rollUp(H3Core h3, int res) {
+        CellCounts snapshot = snapshot();
+        long[] parents = h3.h3ToParent(snapshot.cells, res);
+        ConcurrentCellCounter rolledUp = new ConcurrentCellCounter(parents.length, 1);
+        for (int i = 0; i < parents.length; i++) {
+            if (parents[i] != 0) {
+                rolledUp.add(parents[i], snapshot.counts[i]);
+            }
+        }
+        return rolledUp.snapshot();
+    }
+
+    /**
+     * Returns the slot of the index, adding it if it is not in the table.
+     */
+    private int insert(long h3) {
+        if (h3 == 0) {
+            throw new IllegalArgumentException("Cannot count the invalid index 0");
+        }
+        for (int slot = (int) CellHash.mix(h3) & mask; ; slot = (slot + 1) & mask) {
+            long key = keys.get(slot);
+            if (key == h3) {
+                return slot;
+            }
+            if (key == 0) {
+                // Reserve room before claiming the slot, so racing threads cannot exceed
+                // the maximum and leave no empty slot to end probe sequences.
+                if (size.incrementAndGet() > maxSize) {
+                    size.decrementAndGet();
+                    throw new IllegalStateException("Counter is full");
+                }
+                if (keys.compareAndSet(slot, 0, h3)) {
+                    return slot;
+                }
+                size.decrementAndGet();
+                // Another thread claimed the slot first, possibly for this index
+                if (keys.get(slot) == h3) {
+                    return slot;
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the slot of the index, or -1 if it is not in the table.
+     */
+    private int find(long h3) {
+        if (h3 == 0) {
+            return -1;
+        }
+        for (int slot = (int) CellHash.mix(h3) & mask; ; slot = (slot + 1) & mask) {
+            long key = keys.get(slot);
+            if (key == h3) {
+                return slot;
+            }
+            if (key == 0) {
+                return -1;
+            }
+        }
+    }
+
+    private long count(int slot) {
+        long count = 0;
+        for (AtomicLongArray stripe : stripes) {
+            count += stripe.get(slot);
+        }
+        return count;
+    }
+}
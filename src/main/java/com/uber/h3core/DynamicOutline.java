@@ -0,0 +1,474 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.util.FlatMultiPolygon;
+import com.uber.h3core.util.GeoCoord;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Deque;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * The outline of a set of indexes of one resolution, which is updated as indexes
+ * are added and removed.
+ *
+ * <p>The boundary edges of the set are kept as indexes change, so each change only
+ * visits the boundary of the changed index, rather than the whole set as
+ * {@link H3Core#h3SetToMultiPolygon(java.util.Collection, boolean)} does. The edges
+ * are joined into polygons when the outline is exported, and the polygons are kept
+ * until the next change. Exporting after a change joins the whole boundary again, so
+ * it takes time proportional to the perimeter of the set, not to the size of the
+ * change. For large sets, make changes in batches between exports.
+ *
+ * <p>Create with {@link H3Core#newDynamicOutline()}. Instances are not thread safe.
+ */
+public final class DynamicOutline {
+    /**
+     * Vertices are the same if they are within this many degrees, as the same vertex
+     * found from neighboring indexes may differ in its last bits.
+     */
+    private static final double VERTEX_TOLERANCE_DEGREES = 1e-9;
+    /**
+     * Vertices are hashed by the grid square they are in, with this many squares per
+     * degree. The squares are larger than the tolerance, so vertices which are the same
+     * are always in the same or adjacent squares.
+     */
+    private static final double VERTEX_SQUARES_PER_DEGREE = 1e7;
+
+    private static final byte WKB_LITTLE_ENDIAN = 1;
+    private static final int WKB_POLYGON = 3;
+    private static final int WKB_MULTI_POLYGON = 6;
+
+    private final H3Core h3;
+    private final Set<Long> cells = new HashSet<>();
+    /**
+     * Boundary edges, directed with the set on the left, by their start vertex.
+     */
+    private final Map<Vertex, List<Vertex>> edges = new LinkedHashMap<>();
+    /**
+     * Vertices of the boundary edges, by the grid square they are in. There is one
+     * instance of each vertex, so they are compared by identity.
+     */
+    private final Map<Long, List<Vertex>> vertices = new HashMap<>();
+    /**
+     * Resolution of the indexes, or -1 if there are none.
+     */
+    private int res = -1;
+    /**
+     * Polygons of the current outline, or null if they need to be joined again.
+     */
+    private List<List<List<GeoCoord>>> polygons;
+
+    DynamicOutline(H3Core h3) {
+        this.h3 = h3;
+    }
+
+    /**
+     * Adds the index to the set.
+     *
+     * @return True if the index was not already in the set
+     * @throws IllegalArgumentException The index is invalid, or of a different
+     * resolution than the indexes in the set
+     */
+    public boolean add(long h3Index) {
+        checkIndex(h3Index);
+        if (!cells.add(h3Index)) {
+            return false;
+        }
+        res = h3.h3GetResolution(h3Index);
+
+        List<Vertex> boundary = boundary(h3Index);
+        for (int i = 0; i < boundary.size(); i++) {
+            Vertex from = boundary.get(i);
+            Vertex to = boundary.get((i + 1) % boundary.size());
+            // An edge shared with an index in the set is no longer on the boundary
+            if (!removeEdge(to, from)) {
+                addEdge(from, to);
+            }
+        }
+        releaseUnused(boundary);
+        polygons = null;
+        return true;
+    }
+
+    /**
+     * Removes the index from the set.
+     *
+     * @return True if the index was in the set
+     */
+    public boolean remove(long h3Index) {
+        if (!cells.remove(h3Index)) {
+            return false;
+        }
+        if (cells.isEmpty()) {
+            res = -1;
+        }
+
+        List<Vertex> boundary = boundary(h3Index);
+        for (int i = 0; i < boundary.size(); i++) {
+            Vertex from = boundary.get(i);
+            Vertex to = boundary.get((i + 1) % boundary.size());
+            // An edge shared with an index in the set is now on the boundary
+            if (!removeEdge(from, to)) {
+                addEdge(to, from);
+            }
+        }
+        releaseUnused(boundary);
+        polygons = null;
+        return true;
+    }
+
+    /**
+     * Returns true if the index is in the set.
+     */
+    public boolean contains(long h3Index) {
+        return cells.contains(h3Index);
+    }
+
+    /**
+     * Number of indexes in the set.
+     */
+    public int size() {
+        return cells.size();
+    }
+
+    /**
+     * Returns the outline in the same form as
+     * {@link H3Core#h3SetToMultiPolygon(java.util.Collection, boolean)}.
+     *
+     * @param geoJson Whether to close each loop by repeating its first vertex
+     */
+    public List<List<List<GeoCoord>>> toMultiPolygon(boolean geoJson) {
+        List<List<List<GeoCoord>>> result = new ArrayList<>();
+        for (List<List<GeoCoord>> polygon : polygons()) {
+            List<List<GeoCoord>> loops = new ArrayList<>(polygon.size());
+            for (List<GeoCoord> loop : polygon) {
+                List<GeoCoord> copy = new ArrayList<>(loop.size() + 1);
+                copy.addAll(loop);
+                if (geoJson) {
+                    copy.add(loop.get(0));
+                }
+                loops.add(copy);
+            }
+            result.add(loops);
+        }
+        return result;
+    }
+
+    /**
+     * Returns the outline in compressed sparse row form.
+     */
+    public FlatMultiPolygon toFlat() {
+        List<List<List<GeoCoord>>> polygons = polygons();
+        int numRings = 0;
+        int numVerts = 0;
+        for (List<List<GeoCoord>> polygon : polygons) {
+            numRings += polygon.size();
+            for (List<GeoCoord> loop : polygon) {
+                numVerts += loop.size();
+            }
+        }
+
+        double[] verts = new double[numVerts * 2];
+        int[] ringOffsets = new int[numRings + 1];
+        int[] polygonOffsets = new int[polygons.size() + 1];
+        int ring = 0;
+        int vert = 0;
+        for (int p = 0; p < polygons.size(); p++) {
+            polygonOffsets[p] = ring;
+            for (List<GeoCoord> loop : polygons.get(p)) {
+                ringOffsets[ring++] = vert;
+                for (GeoCoord coord : loop) {
+                    verts[vert * 2] = coord.lat;
+                    verts[vert * 2 + 1] = coord.lng;
+                    vert++;
+                }
+            }
+        }
+        ringOffsets[numRings] = vert;
+        polygonOffsets[polygons.size()] = ring;
+        return new FlatMultiPolygon(verts, ringOffsets, polygonOffsets);
+    }
+
+    /**
+     * Returns the outline as a little endian Well Known Binary MultiPolygon, with
+     * longitude as x and latitude as y, in degrees.
+     */
+    public byte[] toWkb() {
+        List<List<List<GeoCoord>>> polygons = polygons();
+        int size = 1 + 4 + 4;
+        for (List<List<GeoCoord>> polygon : polygons) {
+            size += 1 + 4 + 4;
+            for (List<GeoCoord> loop : polygon) {
+                // Rings are closed by repeating the first vertex
+                size += 4 + (loop.size() + 1) * 16;
+            }
+        }
+
+        ByteBuffer wkb = ByteBuffer.allocate(size).order(ByteOrder.LITTLE_ENDIAN);
+        wkb.put(WKB_LITTLE_ENDIAN).putInt(WKB_MULTI_POLYGON).putInt(polygons.size());
+        for (List<List<GeoCoord>> polygon : polygons) {
+            wkb.put(WKB_LITTLE_ENDIAN).putInt(WKB_POLYGON).putInt(polygon.size());
+            for (List<GeoCoord> loop : polygon) {
+                wkb.putInt(loop.size() + 1);
+                for (GeoCoord coord : loop) {
+                    wkb.putDouble(coord.lng).putDouble(coord.lat);
+                }
+                wkb.putDouble(loop.get(0).lng).putDouble(loop.get(0).lat);
+            }
+        }
+        return wkb.array();
+    }
+
+    private void checkIndex(long h3Index) {
+        if (!h3.h3IsValid(h3Index)) {
+            throw new IllegalArgumentException("Invalid index: " + h3Index);
+        }
+        if (res >= 0 && h3.h3GetResolution(h3Index) != res) {
+            throw new IllegalArgumentException(String.format(
+                    "Index has resolution %d, but the set has resolution %d", h3.h3GetResolution(h3Index), res));
+        }
+    }
+
+    private List<Vertex> boundary(long h3Index) {
+        List<GeoCoord> coords = h3.h3ToGeoBoundary(h3Index);
+        List<Vertex> boundary = new ArrayList<>(coords.size());
+        for (GeoCoord coord : coords) {
+            boundary.add(vertex(coord));
+        }
+        return boundary;
+    }
+
+    /**
+     * Returns the vertex within the tolerance of the coordinate, searching the grid
+     * squares around it, or adds one.
+     */
+    private Vertex vertex(GeoCoord coord) {
+        // +180 and -180 are the same meridian, and are put in the same squares
+        double lng = coord.lng <= -180 + VERTEX_TOLERANCE_DEGREES ? coord.lng + 360 : coord.lng;
+        long latSquare = (long) Math.floor(coord.lat * VERTEX_SQUARES_PER_DEGREE);
+        long lngSquare = (long) Math.floor(lng * VERTEX_SQUARES_PER_DEGREE);
+        for (long dLat = -1; dLat <= 1; dLat++) {
+            for (long dLng = -1; dLng <= 1; dLng++) {
+                List<Vertex> square = vertices.get(squareKey(latSquare + dLat, lngSquare + dLng));
+                if (square == null) {
+                    continue;
+                }
+                for (Vertex vertex : square) {
+                    if (Math.abs(vertex.coord.lat - coord.lat) < VERTEX_TOLERANCE_DEGREES &&
+                            Math.abs(lngDelta(vertex.coord.lng, coord.lng)) < VERTEX_TOLERANCE_DEGREES) {
+                        return vertex;
+                    }
+                }
+            }
+        }
+
+        Vertex vertex = new Vertex(coord, squareKey(latSquare, lngSquare));
+        vertices.computeIfAbsent(vertex.square, k -> new ArrayList<>(1)).add(vertex);
+        return vertex;
+    }
+
+    private static long squareKey(long latSquare, long lngSquare) {
+        return (latSquare << 32) ^ (lngSquare & 0xffffffffL);
+    }
+
+    /**
+     * Forgets vertices no longer on any boundary edge.
+     */
+    private void releaseUnused(List<Vertex> boundary) {
+        for (Vertex vertex : boundary) {
+            if (vertex.numEdges == 0) {
+                List<Vertex> square = vertices.get(vertex.square);
+                if (square != null && square.remove(vertex) && square.isEmpty()) {
+                    vertices.remove(vertex.square);
+                }
+            }
+        }
+    }
+
+    private void addEdge(Vertex from, Vertex to) {
+        edges.computeIfAbsent(from, v -> new ArrayList<>(1)).add(to);
+        from.numEdges++;
+        to.numEdges++;
+    }
+
+    private boolean removeEdge(Vertex from, Vertex to) {
+        List<Vertex> out = edges.get(from);
+        if (out == null || !out.remove(to)) {
+            return false;
+        }
+        if (out.isEmpty()) {
+            edges.remove(from);
+        }
+        from.numEdges--;
+        to.numEdges--;
+        return true;
+    }
+
+    private List<List<List<GeoCoord>>> polygons() {
+        if (polygons == null) {
+            polygons = joinEdges();
+        }
+        return polygons;
+    }
+
+    /**
+     * Joins the boundary edges into loops, and sorts the loops into polygons.
+     */
+    private List<List<List<GeoCoord>>> joinEdges() {
+        Map<Vertex, Deque<Vertex>> remaining = new LinkedHashMap<>();
+        for (Map.Entry<Vertex, List<Vertex>> entry : edges.entrySet()) {
+            remaining.put(entry.getKey(), new ArrayDeque<>(entry.getValue()));
+        }
+
+        List<List<GeoCoord>> outers = new ArrayList<>();
+        List<List<GeoCoord>> holes = new ArrayList<>();
+        for (Vertex start : edges.keySet()) {
+            // Every vertex has as many edges starting as ending at it, so each loop
+            // ends where it started.
+            while (!remaining.get(start).isEmpty()) {
+                List<GeoCoord> loop = new ArrayList<>();
+                Vertex vertex = start;
+                Deque<Vertex> out = remaining.get(start);
+                do {
+                    loop.add(vertex.coord);
+                    vertex = out.poll();
+                    out = remaining.get(vertex);
+                } while (out != null && !out.isEmpty());
+
+                double area = signedArea(loop);
+                if (Double.isNaN(area) || area > 0) {
+                    outers.add(loop);
+                } else {
+                    holes.add(loop);
+                }
+            }
+        }
+
+        List<List<List<GeoCoord>>> result = new ArrayList<>(outers.size());
+        double[] outerAreas = new double[outers.size()];
+        double[] outerLats = new double[outers.size() * 2];
+        for (int i = 0; i < outers.size(); i++) {
+            List<GeoCoord> outer = outers.get(i);
+            List<List<GeoCoord>> polygon = new ArrayList<>();
+            polygon.add(Collections.unmodifiableList(outer));
+            result.add(polygon);
+            outerAreas[i] = Math.abs(signedArea(outer));
+            outerLats[i * 2] = Double.POSITIVE_INFINITY;
+            outerLats[i * 2 + 1] = Double.NEGATIVE_INFINITY;
+            for (GeoCoord coord : outer) {
+                outerLats[i * 2] = Math.min(outerLats[i * 2], coord.lat);
+                outerLats[i * 2 + 1] = Math.max(outerLats[i * 2 + 1], coord.lat);
+            }
+        }
+        for (List<GeoCoord> hole : holes) {
+            // The smallest outer loop containing the hole. Loops not spanning its
+            // latitude are skipped without walking their vertices.
+            GeoCoord point = hole.get(0);
+            int container = -1;
+            double containerArea = Double.POSITIVE_INFINITY;
+            for (int i = 0; i < outers.size(); i++) {
+                double area = outerAreas[i];
+                if (area < containerArea && point.lat >= outerLats[i * 2] && point.lat <= outerLats[i * 2 + 1] &&
+                        contains(outers.get(i), point)) {
+                    container = i;
+                    containerArea = area;
+                }
+            }
+            // Only degenerate input leaves a hole outside every outer loop
+            if (container >= 0) {
+                result.get(container).add(Collections.unmodifiableList(hole));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Difference in longitude from a to b, taking the shorter way around.
+     */
+    private static double lngDelta(double a, double b) {
+        double delta = b - a;
+        if (delta > 180) {
+            delta -= 360;
+        } else if (delta < -180) {
+            delta += 360;
+        }
+        return delta;
+    }
+
+    /**
+     * Twice the signed area of the loop in degrees, which is positive for
+     * counter-clockwise loops, or NaN for loops around a pole.
+     */
+    private static double signedArea(List<GeoCoord> loop) {
+        double sum = 0;
+        double lng = loop.get(0).lng;
+        for (int i = 0; i < loop.size(); i++) {
+            GeoCoord a = loop.get(i);
+            GeoCoord b = loop.get((i + 1) % loop.size());
+            double nextLng = lng + lngDelta(a.lng, b.lng);
+            sum += (lng - nextLng) * (a.lat + b.lat);
+            lng = nextLng;
+        }
+        return Math.abs(lng - loop.get(0).lng) > 180 ? Double.NaN : sum;
+    }
+
+    /**
+     * Ray casting test of whether the point is inside the loop.
+     */
+    private static boolean contains(List<GeoCoord> loop, GeoCoord point) {
+        boolean inside = false;
+        for (int i = 0; i < loop.size(); i++) {
+            GeoCoord a = loop.get(i);
+            GeoCoord b = loop.get((i + 1) % loop.size());
+            if ((a.lat > point.lat) == (b.lat > point.lat)) {
+                continue;
+            }
+            // Longitudes relative to the point
+            double aLng = lngDelta(point.lng, a.lng);
+            double bLng = aLng + lngDelta(a.lng, b.lng);
+            double crossing = aLng + (point.lat - a.lat) * (bLng - aLng) / (b.lat - a.lat);
+            if (crossing > 0) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    /**
+     * A boundary vertex, with the number of boundary edges starting or ending at it.
+     */
+    private static final class Vertex {
+        final GeoCoord coord;
+        final long square;
+        int numEdges;
+
+        Vertex(GeoCoord coord, long square) {
+            this.coord = coord;
+            this.square = square;
+        }
+    }
+}
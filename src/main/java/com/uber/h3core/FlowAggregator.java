@@ -0,0 +1,262 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.exceptions.LineUndefinedException;
+import com.uber.h3core.util.CellCounts;
+import com.uber.h3core.util.FlowCounts;
+
+import java.util.List;
+
+/**
+ * Aggregates trips into counts per origin and destination cell, and optionally into
+ * counts of traversals per unidirectional edge along the line between them.
+ *
+ * <p>Create with {@link H3Core#newFlowAggregator(int, boolean)}. Instances are not
+ * thread safe; to aggregate from several threads, give each its own aggregator and
+ * combine them with {@link #merge(FlowAggregator)}.
+ */
+public final class FlowAggregator {
+    private final H3Core h3;
+    private final int res;
+    private final boolean countEdges;
+
+    private final PairCounts flows = new PairCounts();
+    /**
+     * Traversals, keyed by the cells on either side of the edge.
+     */
+    private final PairCounts traversals = new PairCounts();
+    private long unroutedTrips;
+
+    FlowAggregator(H3Core h3, int res, boolean countEdges) {
+        H3Core.checkResolution(res);
+        this.h3 = h3;
+        this.res = res;
+        this.countEdges = countEdges;
+    }
+
+    /**
+     * Adds a batch of trips.
+     *
+     * @param originLatLngs Interleaved latitudes and longitudes of the origins in degrees,
+     *                      that is <code>lat0, lng0, lat1, lng1, ...</code>
+     * @param destinationLatLngs Destinations of the trips, in the same form
+     * @throws IllegalArgumentException The arrays differ in length, or a latitude or
+     *                                  longitude is invalid
+     */
+    public void add(double[] originLatLngs, double[] destinationLatLngs) {
+        if (originLatLngs.length != destinationLatLngs.length) {
+            throw new IllegalArgumentException(String.format(
+                    "originLatLngs (length %d) and destinationLatLngs (length %d) must be the same length",
+                    originLatLngs.length, destinationLatLngs.length));
+        }
+        add(h3.geoToH3(originLatLngs, res), h3.geoToH3(destinationLatLngs, res));
+    }
+
+    /**
+     * Adds a batch of trips between cells of the resolution of this aggregator.
+     *
+     * @throws IllegalArgumentException The arrays differ in length, or an index is not of
+     *                                  the resolution of this aggregator
+     */
+    public void add(long[] origins, long[] destinations) {
+        if (origins.length != destinations.length) {
+            throw new IllegalArgumentException(String.format(
+                    "origins (length %d) and destinations (length %d) must be the same length",
+                    origins.length, destinations.length));
+        }
+        for (int i = 0; i < origins.length; i++) {
+            checkCell(origins[i]);
+            checkCell(destinations[i]);
+        }
+
+        for (int i = 0; i < origins.length; i++) {
+            flows.add(origins[i], destinations[i], 1);
+            if (countEdges && origins[i] != destinations[i]) {
+                route(origins[i], destinations[i]);
+            }
+        }
+    }
+
+    /**
+     * Adds the counts of another aggregator to this one. The other aggregator is not
+     * modified.
+     *
+     * @throws IllegalArgumentException The other aggregator is this one, has a different
+     *                                  resolution, or does not count the same things
+     */
+    public void merge(FlowAggregator other) {
+        if (other == this) {
+            throw new IllegalArgumentException("Cannot merge an aggregator into itself");
+        }
+        if (other.res != res || other.countEdges != countEdges) {
+            throw new IllegalArgumentException("Aggregators must have the same resolution and countEdges");
+        }
+        flows.addAll(other.flows);
+        traversals.addAll(other.traversals);
+        unroutedTrips += other.unroutedTrips;
+    }
+
+    /**
+     * Returns the number of trips between each origin and destination.
+     */
+    public FlowCounts flowCounts() {
+        int[] order = flows.sortedOrder();
+        long[] origins = new long[order.length];
+        long[] destinations = new long[order.length];
+        long[] counts = new long[order.length];
+        for (int i = 0; i < order.length; i++) {
+            origins[i] = flows.firsts[order[i]];
+            destinations[i] = flows.seconds[order[i]];
+            counts[i] = flows.counts[order[i]];
+        }
+        return new FlowCounts(origins, destinations, counts);
+    }
+
+    /**
+     * Returns the number of trips traversing each unidirectional edge, along the line
+     * from their origin to their destination. Empty unless edges are counted.
+     */
+    public CellCounts edgeCounts() {
+        int[] order = traversals.sortedOrder();
+        long[] edges = new long[order.length];
+        for (int i = 0; i < order.length; i++) {
+            edges[i] = h3.getH3UnidirectionalEdge(traversals.firsts[order[i]], traversals.seconds[order[i]]);
+        }
+        int[] edgeOrder = IndexSort.sortedOrder(edges);
+        long[] sortedEdges = new long[edges.length];
+        long[] counts = new long[edges.length];
+        for (int i = 0; i < edgeOrder.length; i++) {
+            sortedEdges[i] = edges[edgeOrder[i]];
+            counts[i] = traversals.counts[order[edgeOrder[i]]];
+        }
+        return new CellCounts(sortedEdges, counts);
+    }
+
+    /**
+     * Number of trips whose edges were not counted because the line between their origin
+     * and destination is not defined, for example across a pentagon.
+     */
+    public long getUnroutedTrips() {
+        return unroutedTrips;
+    }
+
+    public int getRes() {
+        return res;
+    }
+
+    private void route(long origin, long destination) {
+        List<Long> line;
+        try {
+            line = h3.h3Line(origin, destination);
+        } catch (LineUndefinedException e) {
+            unroutedTrips++;
+            return;
+        }
+        long previous = line.get(0);
+        for (int i = 1; i < line.size(); i++) {
+            long cell = line.get(i);
+            traversals.add(previous, cell, 1);
+            previous = cell;
+        }
+    }
+
+    private void checkCell(long cell) {
+        if (cell == 0 || h3.h3GetResolution(cell) != res) {
+            throw new IllegalArgumentException(String.format("Index %x is not of resolution %d", cell, res));
+        }
+    }
+
+    /**
+     * Counts keyed by pairs of indexes, in an open addressing table. A slot is used if its
+     * first index is not 0.
+     */
+    private static final class PairCounts {
+        private static final int INITIAL_CAPACITY = 1024;
+
+        long[] firsts = new long[INITIAL_CAPACITY];
+        long[] seconds = new long[INITIAL_CAPACITY];
+        long[] counts = new long[INITIAL_CAPACITY];
+        int size;
+
+        void add(long first, long second, long count) {
+            if ((size + 1) * 2 > firsts.length) {
+                grow();
+            }
+            int mask = firsts.length - 1;
+            int slot = hash(first, second) & mask;
+            while (firsts[slot] != 0) {
+                if (firsts[slot] == first && seconds[slot] == second) {
+                    counts[slot] += count;
+                    return;
+                }
+                slot = (slot + 1) & mask;
+            }
+            firsts[slot] = first;
+            seconds[slot] = second;
+            counts[slot] = count;
+            size++;
+        }
+
+        void addAll(PairCounts other) {
+            for (int slot = 0; slot < other.firsts.length; slot++) {
+                if (other.firsts[slot] != 0) {
+                    add(other.firsts[slot], other.seconds[slot], other.counts[slot]);
+                }
+            }
+        }
+
+        /**
+         * Slots of the pairs, sorted by first and then second index.
+         */
+        int[] sortedOrder() {
+            int[] slots = new int[size];
+            int numSlots = 0;
+            for (int slot = 0; slot < firsts.length; slot++) {
+                if (firsts[slot] != 0) {
+                    slots[numSlots++] = slot;
+                }
+            }
+            int[] order = IndexSort.sortedOrder(size, (a, b) -> {
+                int cmp = Long.compare(firsts[slots[a]], firsts[slots[b]]);
+                return cmp != 0 ? cmp : Long.compare(seconds[slots[a]], seconds[slots[b]]);
+            });
+            for (int i = 0; i < order.length; i++) {
+                order[i] = slots[order[i]];
+            }
+            return order;
+        }
+
+        private void grow() {
+            long[] oldFirsts = firsts;
+            long[] oldSeconds = seconds;
+            long[] oldCounts = counts;
+            firsts = new long[oldFirsts.length * 2];
+            seconds = new long[oldFirsts.length * 2];
+            counts = new long[oldFirsts.length * 2];
+            size = 0;
+            for (int slot = 0; slot < oldFirsts.length; slot++) {
+                if (oldFirsts[slot] != 0) {
+                    add(oldFirsts[slot], oldSeconds[slot], oldCounts[slot]);
+                }
+            }
+        }
+
+        private static int hash(long first, long second) {
+            return (int) CellHash.mix(CellHash.mix(first) + second);
+        }
+    }
+}
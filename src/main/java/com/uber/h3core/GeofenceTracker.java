@@ -0,0 +1,321 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.util.GeofenceDelta;
+import com.uber.h3core.util.GroupedCells;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+
+/**
+ * Detects entities entering and exiting geofences as their positions arrive.
+ *
+ * <p>Each position is indexed at a fixed resolution, and nothing more is done while an
+ * entity stays in the same cell. When it moves to another cell, the geofences containing
+ * that cell are found by looking up its ancestors in a sorted index of the geofences'
+ * compacted cells, and compared to the geofences it was in.
+ *
+ * <p>Create with {@link H3Core#newGeofenceTracker(GroupedCells, int)}. Instances are not
+ * thread safe.
+ */
+public final class GeofenceTracker {
+    private static final int INITIAL_CAPACITY = 1024;
+    private static final int[] NO_FENCES = new int[0];
+
+    private final H3Core h3;
+    private final int res;
+
+    /**
+     * Cells of all geofences, sorted, with the geofences containing cell <code>i</code>
+     * in <code>fenceIds[fenceOffsets[i]]</code> to <code>fenceIds[fenceOffsets[i + 1] - 1]</code>.
+     */
+    private final long[] fenceCells;
+    private final int[] fenceOffsets;
+    private final int[] fenceIds;
+    /**
+     * Resolutions of the geofence cells, coarsest first.
+     */
+    private final int[] fenceResolutions;
+    /**
+     * Geofences of a cell being looked up, before they are known to differ.
+     */
+    private final int[] scratch;
+
+    /**
+     * Entities, in an open addressing table. A slot is used if its cell is not 0. Unused
+     * slots have no geofences, so memberships are never null.
+     */
+    private long[] entities;
+    private long[] cells;
+    private int[][] memberships;
+    private int size;
+
+    GeofenceTracker(H3Core h3, GroupedCells fences, int res) {
+        H3Core.checkResolution(res);
+        this.h3 = h3;
+        this.res = res;
+
+        Map<Long, List<Integer>> index = new TreeMap<>();
+        boolean[] resolutions = new boolean[res + 1];
+        for (int fence = 0; fence < fences.numGroups(); fence++) {
+            for (int i = fences.offsets[fence]; i < fences.offsets[fence + 1]; i++) {
+                long cell = fences.cells[i];
+                int cellRes = h3.h3GetResolution(cell);
+                if (cell == 0 || cellRes > res) {
+                    throw new IllegalArgumentException(String.format(
+                            "Geofence %d has index %x, which is not of resolution %d or coarser", fence, cell, res));
+                }
+                resolutions[cellRes] = true;
+                index.computeIfAbsent(cell, c -> new ArrayList<>()).add(fence);
+            }
+        }
+
+        fenceCells = new long[index.size()];
+        fenceOffsets = new int[index.size() + 1];
+        List<Integer> ids = new ArrayList<>();
+        int i = 0;
+        for (Map.Entry<Long, List<Integer>> entry : index.entrySet()) {
+            fenceCells[i] = entry.getKey();
+            ids.addAll(entry.getValue());
+            fenceOffsets[++i] = ids.size();
+        }
+        fenceIds = ids.stream().mapToInt(Integer::intValue).toArray();
+        int numResolutions = 0;
+        int[] presentResolutions = new int[res + 1];
+        for (int r = 0; r <= res; r++) {
+            if (resolutions[r]) {
+                presentResolutions[numResolutions++] = r;
+            }
+        }
+        fenceResolutions = Arrays.copyOf(presentResolutions, numResolutions);
+        scratch = new int[fenceIds.length];
+
+        allocate(INITIAL_CAPACITY);
+    }
+
+    /**
+     * Updates the position of the entity.
+     *
+     * @param entity ID of the entity
+     * @param lat Latitude in degrees
+     * @param lng Longitude in degrees
+     * @return Geofences entered and exited since the last position, or
+     *         {@link GeofenceDelta#EMPTY} if none were
+     * @throws IllegalArgumentException Latitude or longitude is invalid
+     */
+    public GeofenceDelta update(long entity, double lat, double lng) {
+        return update(entity, h3.geoToH3(lat, lng, res));
+    }
+
+    /**
+     * Updates the position of the entity to a cell of the resolution of this tracker.
+     *
+     * @param entity ID of the entity
+     * @param cell Index of the position
+     * @return Geofences entered and exited since the last position, or
+     *         {@link GeofenceDelta#EMPTY} if none were
+     * @throws IllegalArgumentException The index is not of the resolution of this tracker
+     */
+    public GeofenceDelta update(long entity, long cell) {
+        int slot = find(entity);
+        if (slot >= 0 && cells[slot] == cell) {
+            return GeofenceDelta.EMPTY;
+        }
+        if (cell == 0 || h3.h3GetResolution(cell) != res) {
+            throw new IllegalArgumentException(String.format("Index %x is not of resolution %d", cell, res));
+        }
+
+        int numFences = lookup(cell);
+        int[] previous;
+        if (slot < 0) {
+            if ((size + 1) * 2 > entities.length) {
+                grow();
+            }
+            slot = insert(entity);
+            memberships[slot] = NO_FENCES;
+            previous = NO_FENCES;
+        } else {
+            previous = memberships[slot];
+        }
+        cells[slot] = cell;
+
+        if (sameFences(previous, numFences)) {
+            return GeofenceDelta.EMPTY;
+        }
+        int[] current = numFences == 0 ? NO_FENCES : Arrays.copyOf(scratch, numFences);
+        memberships[slot] = current;
+        return new GeofenceDelta(difference(current, previous), difference(previous, current));
+    }
+
+    /**
+     * Stops tracking the entity.
+     *
+     * @return The geofences the entity was in, as exited
+     */
+    public GeofenceDelta remove(long entity) {
+        int slot = find(entity);
+        if (slot < 0) {
+            return GeofenceDelta.EMPTY;
+        }
+        int[] previous = memberships[slot];
+        delete(slot);
+        return previous.length == 0 ? GeofenceDelta.EMPTY : new GeofenceDelta(NO_FENCES, previous);
+    }
+
+    /**
+     * Returns the geofences the entity is in, sorted.
+     */
+    public int[] geofences(long entity) {
+        int slot = find(entity);
+        return slot < 0 ? NO_FENCES : memberships[slot].clone();
+    }
+
+    /**
+     * Number of entities tracked.
+     */
+    public int size() {
+        return size;
+    }
+
+    /**
+     * Finds the geofences containing the cell, into the start of <code>scratch</code>,
+     * sorted.
+     *
+     * @return Number of geofences
+     */
+    private int lookup(long cell) {
+        int numFences = 0;
+        for (int r : fenceResolutions) {
+            int i = Arrays.binarySearch(fenceCells, h3.h3ToParent(cell, r));
+            if (i >= 0) {
+                for (int j = fenceOffsets[i]; j < fenceOffsets[i + 1]; j++) {
+                    scratch[numFences++] = fenceIds[j];
+                }
+            }
+        }
+        Arrays.sort(scratch, 0, numFences);
+        // A geofence whose cells were not compacted could contain the cell twice
+        int unique = 0;
+        for (int i = 0; i < numFences; i++) {
+            if (unique == 0 || scratch[unique - 1] != scratch[i]) {
+                scratch[unique++] = scratch[i];
+            }
+        }
+        return unique;
+    }
+
+    /**
+     * Returns true if the first <code>numFences</code> of <code>scratch</code> are the
+     * same as <code>fences</code>.
+     */
+    private boolean sameFences(int[] fences, int numFences) {
+        if (fences.length != numFences) {
+            return false;
+        }
+        for (int i = 0; i < numFences; i++) {
+            if (fences[i] != scratch[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Elements of sorted array <code>a</code> not in sorted array <code>b</code>.
+     */
+    private static int[] difference(int[] a, int[] b) {
+        int[] out = new int[a.length];
+        int size = 0;
+        int j = 0;
+        for (int value : a) {
+            while (j < b.length && b[j] < value) {
+                j++;
+            }
+            if (j == b.length || b[j] != value) {
+                out[size++] = value;
+            }
+        }
+        return size == out.length ? out : Arrays.copyOf(out, size);
+    }
+
+    private int find(long entity) {
+        int mask = entities.length - 1;
+        for (int slot = (int) CellHash.mix(entity) & mask; cells[slot] != 0; slot = (slot + 1) & mask) {
+            if (entities[slot] == entity) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    private int insert(long entity) {
+        int mask = entities.length - 1;
+        int slot = (int) CellHash.mix(entity) & mask;
+        while (cells[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        entities[slot] = entity;
+        size++;
+        return slot;
+    }
+
+    /**
+     * Empties the slot, moving back later entries of its probe sequence so they can still
+     * be found.
+     */
+    private void delete(int slot) {
+        int mask = entities.length - 1;
+        int hole = slot;
+        for (int next = (hole + 1) & mask; cells[next] != 0; next = (next + 1) & mask) {
+            int home = (int) CellHash.mix(entities[next]) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                entities[hole] = entities[next];
+                cells[hole] = cells[next];
+                memberships[hole] = memberships[next];
+                hole = next;
+            }
+        }
+        cells[hole] = 0;
+        memberships[hole] = NO_FENCES;
+        size--;
+    }
+
+    private void grow() {
+        long[] oldEntities = entities;
+        long[] oldCells = cells;
+        int[][] oldMemberships = memberships;
+        allocate(oldEntities.length * 2);
+        for (int slot = 0; slot < oldEntities.length; slot++) {
+            if (oldCells[slot] != 0) {
+                int newSlot = insert(oldEntities[slot]);
+                cells[newSlot] = oldCells[slot];
+                memberships[newSlot] = oldMemberships[slot];
+            }
+        }
+    }
+
+    private void allocate(int capacity) {
+        entities = new long[capacity];
+        cells = new long[capacity];
+        memberships = new int[capacity][];
+        Arrays.fill(memberships, NO_FENCES);
+        size = 0;
+    }
+}
@@ -19,14 +19,22 @@ import com.uber.h3core.exceptions.DistanceUndefinedException;
 import com.uber.h3core.exceptions.LineUndefinedException;
 import com.uber.h3core.exceptions.LocalIjUndefinedException;
 import com.uber.h3core.exceptions.PentagonEncounteredException;
+import com.uber.h3core.util.CellMesh;
+import com.uber.h3core.util.CellPyramid;
+import com.uber.h3core.util.CellRuns;
 import com.uber.h3core.util.CoordIJ;
 import com.uber.h3core.util.GeoCoord;
+import com.uber.h3core.util.GroupedCells;
+import com.uber.h3core.util.RegionBoundary;
 
 import java.io.IOException;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collection;
 import java.util.Collections;
 import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ForkJoinPool;
 import java.util.stream.Collectors;
 import java.util.stream.IntStream;
 
@@ -51,6 +59,9 @@ public class H3Core {
     private static final long H3_RES_OFFSET = 52L;
     private static final long H3_RES_MASK = 0xfL << H3_RES_OFFSET;
     private static final long H3_RES_MASK_NEGATIVE = ~H3_RES_MASK;
+    // Constants for the base cell bits in an H3 index.
+    private static final long H3_BC_OFFSET = 45L;
+    private static final long H3_BC_MASK = 0x7fL << H3_BC_OFFSET;
     /**
      * Mask for the indexing digits in an H3 index.
      *
@@ -60,6 +71,24 @@ public class H3Core {
 
     private static final long INVALID_INDEX = 0L;
 
+    /**
+     * Number of vertices at which <code>polyfill</code> prepares the polygon rather than
+     * passing it directly to the core library.
+     */
+    private static final int PREPARED_POLYFILL_MIN_VERTS = 256;
+
+    // Operations of cellMorphology, from morphology.h
+    private static final int MORPHOLOGY_DILATE = 0;
+    private static final int MORPHOLOGY_ERODE = 1;
+    private static final int MORPHOLOGY_OPEN = 2;
+    private static final int MORPHOLOGY_CLOSE = 3;
+
+    /**
+     * Bounding boxes of the resolution 0 indexes, by base cell, in the form returned by
+     * <code>cellBBox</code>, or null if they have not been found yet.
+     */
+    private static volatile double[] res0BBoxes;
+
     /**
      * Native implementation of the H3 library.
      */
@@ -113,6 +142,26 @@ public class H3Core {
         this.h3Api = h3Api;
     }
 
+    /**
+     * Starts calling every function on sample inputs, on a low priority daemon thread, so
+     * that the native library is bound and the Java code is compiled before it is needed.
+     * Without this, the first few thousand calls in a process are slower. Only the first
+     * call starts a warmup; it is shared by all instances.
+     *
+     * @return Completed when the warmup finishes, or completed exceptionally if it failed
+     */
+    public CompletableFuture<Void> warmup() {
+        return H3CoreWarmup.start(this);
+    }
+
+    /**
+     * Returns true if {@link #warmup()} was started and finished successfully. This can be
+     * used by a readiness check.
+     */
+    public boolean isWarmedUp() {
+        return H3CoreWarmup.isDone();
+    }
+
     /**
      * Returns true if this is a valid H3 index.
      */
@@ -188,6 +237,70 @@ public class H3Core {
         return h3ToString(geoToH3(lat, lng, res));
     }
 
+    /**
+     * Find the H3 indexes of the resolution <code>res</code> cells containing each of the
+     * lat/lon pairs (in degrees), using a single native call.
+     *
+     * @param latLngs Interleaved latitudes and longitudes in degrees, that is
+     *                <code>lat0, lng0, lat1, lng1, ...</code>
+     * @param res Resolution, 0 &lt;= res &lt;= 15
+     * @return The H3 indexes, one per lat/lon pair.
+     * @throws IllegalArgumentException An odd number of coordinates was given, or latitude,
+     * longitude, or resolution are out of range.
+     */
+    public long[] geoToH3(double[] latLngs, int res) {
+        return geoToH3(latLngs, res, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Find the H3 indexes of the resolution <code>res</code> cells containing each of the
+     * lat/lon pairs (in degrees), using a single native call. Large arrays are split
+     * across native threads.
+     *
+     * @param latLngs Interleaved latitudes and longitudes in degrees, that is
+     *                <code>lat0, lng0, lat1, lng1, ...</code>
+     * @param res Resolution, 0 &lt;= res &lt;= 15
+     * @param numThreads Maximum number of threads to use
+     * @return The H3 indexes, one per lat/lon pair.
+     * @throws IllegalArgumentException An odd number of coordinates was given, or latitude,
+     * longitude, resolution, or number of threads are out of range.
+     */
+    public long[] geoToH3(double[] latLngs, int res, int numThreads) {
+        checkResolution(res);
+        checkNumThreads(numThreads);
+        long[] results = new long[checkLatLngs(latLngs)];
+        h3Api.geoToH3Batch(toRadiansArray(latLngs), res, numThreads, results);
+        checkGeoToH3Results(results);
+        return results;
+    }
+
+    /**
+     * Find the H3 indexes of the resolution <code>res</code> cells containing each of the
+     * lat/lon pairs (in degrees), using approximate trigonometry where possible.
+     *
+     * <p>Each point is first tested against the edges of recently found cells, using
+     * polynomial sine and cosine. A point is only assigned this way when it is inside the
+     * cell by more than 1e-10 radians (about 0.6mm); all other points, including those near
+     * cell edges and those in cells containing distortion vertices, are indexed with the
+     * exact {@link #geoToH3(double, double, int)}. The result can differ from the exact
+     * result only for points within that band of an edge or where an edge crosses an
+     * icosahedron face. This is fastest for spatially clustered inputs at coarse resolutions.
+     *
+     * @param latLngs Interleaved latitudes and longitudes in degrees, that is
+     *                <code>lat0, lng0, lat1, lng1, ...</code>
+     * @param res Resolution, 0 &lt;= res &lt;= 15
+     * @return The H3 indexes, one per lat/lon pair.
+     * @throws IllegalArgumentException An odd number of coordinates was given, or latitude,
+     * longitude, or resolution are out of range.
+     */
+    public long[] geoToH3Approx(double[] latLngs, int res) {
+        checkResolution(res);
+        long[] results = new long[checkLatLngs(latLngs)];
+        h3Api.geoToH3BatchApprox(toRadiansArray(latLngs), res, results);
+        checkGeoToH3Results(results);
+        return results;
+    }
+
     /**
      * Find the latitude, longitude (both in degrees) center point of the cell.
      */
@@ -208,6 +321,33 @@ public class H3Core {
         return h3ToGeo(stringToH3(h3Address));
     }
 
+    /**
+     * Find the center points of the cells, using all available processors.
+     *
+     * @see #h3ToGeo(long[], int)
+     */
+    public double[] h3ToGeo(long[] h3) {
+        return h3ToGeo(h3, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Find the center points of the cells, using a single native call. Large arrays are
+     * split across native threads.
+     *
+     * @param h3 Indexes to find the centers of
+     * @param numThreads Maximum number of threads to use
+     * @return Interleaved latitudes and longitudes of the centers in degrees, that is
+     *         <code>lat0, lng0, lat1, lng1, ...</code>. The center of an invalid index is NaN.
+     * @throws IllegalArgumentException numThreads is less than 1
+     */
+    public double[] h3ToGeo(long[] h3, int numThreads) {
+        checkNumThreads(numThreads);
+        double[] out = new double[h3.length * 2];
+        h3Api.h3ToGeoBatch(h3, numThreads, out);
+        toDegreesInPlace(out, out.length);
+        return out;
+    }
+
     /**
      * Find the cell boundary in latitude, longitude (degrees) coordinates for the cell
      */
@@ -232,6 +372,42 @@ public class H3Core {
         return h3ToGeoBoundary(stringToH3(h3Address));
     }
 
+    /**
+     * Find the boundaries of the cells, using all available processors.
+     *
+     * @see #h3ToGeoBoundary(long[], int[], int)
+     */
+    public double[] h3ToGeoBoundary(long[] h3, int[] offsets) {
+        return h3ToGeoBoundary(h3, offsets, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Find the boundaries of the cells, using a single native call. Large arrays are split
+     * across native threads.
+     *
+     * <p>The boundary of <code>h3[i]</code> is the vertices <code>offsets[i]</code> to
+     * <code>offsets[i + 1] - 1</code>.
+     *
+     * @param h3 Indexes to find the boundaries of
+     * @param offsets Output, of length at least <code>h3.length + 1</code>, for the first vertex
+     *                of each boundary followed by the number of vertices
+     * @param numThreads Maximum number of threads to use
+     * @return Interleaved latitudes and longitudes of each vertex, in degrees. The invalid
+     *         index has no vertices.
+     * @throws IllegalArgumentException offsets is too short, or numThreads is less than 1
+     */
+    public double[] h3ToGeoBoundary(long[] h3, int[] offsets, int numThreads) {
+        checkBoundaryOffsets(h3, offsets);
+        checkNumThreads(numThreads);
+        double[] out = new double[h3.length * MAX_CELL_BNDRY_VERTS * 2];
+        if (h3.length > 0) {
+            h3Api.h3ToGeoBoundaryBatch(h3, numThreads, offsets, out);
+        }
+        int length = offsets[h3.length] * 2;
+        toDegreesInPlace(out, length);
+        return Arrays.copyOf(out, length);
+    }
+
     /**
      * Neighboring indexes in all directions.
      *
@@ -469,6 +645,40 @@ public class H3Core {
         return distance;
     }
 
+    /**
+     * Returns the distance in grid cells between each pair of indexes, using all available
+     * processors.
+     *
+     * @see #h3Distance(long[], long[], int)
+     */
+    public int[] h3Distance(long[] origins, long[] destinations) {
+        return h3Distance(origins, destinations, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Returns the distance in grid cells from each of the origins to the destination at the
+     * same position, using a single native call. Large arrays are split across native
+     * threads.
+     *
+     * @param origins Indexes to find the distances from
+     * @param destinations Indexes to find the distances to
+     * @param numThreads Maximum number of threads to use
+     * @return Distance for each pair, or -1 where it is not defined, as in
+     *         {@link #h3Distance(long, long)}.
+     * @throws IllegalArgumentException The arrays differ in length, or numThreads is less than 1
+     */
+    public int[] h3Distance(long[] origins, long[] destinations, int numThreads) {
+        if (origins.length != destinations.length) {
+            throw new IllegalArgumentException(String.format(
+                    "origins (length %d) and destinations (length %d) must be the same length",
+                    origins.length, destinations.length));
+        }
+        checkNumThreads(numThreads);
+        int[] out = new int[origins.length];
+        h3Api.h3DistanceBatch(origins, destinations, numThreads, out);
+        return out;
+    }
+
     /**
      * Converts <code>h3</code> to IJ coordinates in a local coordinate space defined by
      * <code>origin</code>.
@@ -642,6 +852,138 @@ public class H3Core {
         return nonZeroLongArrayToList(results);
     }
 
+    /**
+     * Run-length encodes a trajectory as the sequence of cells its points are in.
+     *
+     * @see #trajectoryToCells(double[], long[], int[], int)
+     */
+    public CellRuns trajectoryToCells(double[] latLngs, long[] times, int res) {
+        return trajectoryToCells(latLngs, times, new int[] {0, times.length}, res);
+    }
+
+    /**
+     * Run-length encodes trajectories as the sequences of cells their points are in.
+     *
+     * <p>Consecutive points in the same cell become one run, with the number of points and
+     * the time of the first. Where consecutive points are in cells that are not neighbors,
+     * the cells of {@link #h3Line(long, long)} between them are added as runs of no points,
+     * with times interpolated between the two points, so each trajectory is a contiguous
+     * sequence of cells. If the line is not defined, for example across a pentagon, the
+     * gap is left.
+     *
+     * @param latLngs Interleaved latitudes and longitudes of the points in degrees, that is
+     *                <code>lat0, lng0, lat1, lng1, ...</code>
+     * @param times Time of each point, such as milliseconds since the epoch
+     * @param offsets Start of each trajectory in the points, followed by the end of the last
+     * @param res Resolution, 0 &lt;= res &lt;= 15
+     * @return Runs of each trajectory
+     * @throws IllegalArgumentException An odd number of coordinates was given, times is not one
+     * per point, offsets are out of range, or latitude, longitude, or resolution are out of
+     * range.
+     */
+    public CellRuns trajectoryToCells(double[] latLngs, long[] times, int[] offsets, int res) {
+        int numPoints = checkLatLngs(latLngs);
+        if (times.length != numPoints) {
+            throw new IllegalArgumentException(String.format(
+                    "times (length %d) must have one element per point (%d)", times.length, numPoints));
+        }
+        checkOffsets(offsets, numPoints, "offsets");
+        long[] cells = geoToH3(latLngs, res);
+        int numTrajectories = offsets.length - 1;
+
+        // Runs of the same cell, before gaps are filled
+        int[] runStarts = new int[numPoints];
+        int[] trajectoryRuns = new int[offsets.length];
+        int numRuns = 0;
+        for (int t = 0; t < numTrajectories; t++) {
+            trajectoryRuns[t] = numRuns;
+            for (int i = offsets[t]; i < offsets[t + 1]; i++) {
+                if (i == offsets[t] || cells[i] != cells[i - 1]) {
+                    runStarts[numRuns++] = i;
+                }
+            }
+        }
+        trajectoryRuns[numTrajectories] = numRuns;
+
+        // Each run and the next in its trajectory, or itself for the last
+        long[] from = new long[numRuns];
+        long[] to = new long[numRuns];
+        for (int t = 0; t < numTrajectories; t++) {
+            for (int r = trajectoryRuns[t]; r < trajectoryRuns[t + 1]; r++) {
+                from[r] = cells[runStarts[r]];
+                to[r] = r + 1 < trajectoryRuns[t + 1] ? cells[runStarts[r + 1]] : from[r];
+            }
+        }
+        int[] distances = h3Distance(from, to);
+        int capacity = numRuns;
+        for (int distance : distances) {
+            capacity += Math.max(distance - 1, 0);
+        }
+
+        long[] outCells = new long[capacity];
+        int[] counts = new int[capacity];
+        long[] entryTimes = new long[capacity];
+        int[] outOffsets = new int[offsets.length];
+        int size = 0;
+        for (int t = 0; t < numTrajectories; t++) {
+            outOffsets[t] = size;
+            for (int r = trajectoryRuns[t]; r < trajectoryRuns[t + 1]; r++) {
+                int start = runStarts[r];
+                int end = r + 1 < trajectoryRuns[t + 1] ? runStarts[r + 1] : offsets[t + 1];
+                outCells[size] = from[r];
+                counts[size] = end - start;
+                entryTimes[size] = times[start];
+                size++;
+                if (distances[r] > 1) {
+                    size = fillGap(from[r], to[r], times[end - 1], times[end], outCells, entryTimes, size);
+                }
+            }
+        }
+        outOffsets[numTrajectories] = size;
+
+        if (size < capacity) {
+            outCells = Arrays.copyOf(outCells, size);
+            counts = Arrays.copyOf(counts, size);
+            entryTimes = Arrays.copyOf(entryTimes, size);
+        }
+        return new CellRuns(outCells, counts, entryTimes, outOffsets);
+    }
+
+    /**
+     * Decodes run-length encoded trajectories to paths through the centers of their cells.
+     *
+     * @param runs Runs, such as from {@link #trajectoryToCells(double[], long[], int[], int)}
+     * @return Interleaved latitudes and longitudes of the center of each run in degrees, that is
+     *         <code>lat0, lng0, lat1, lng1, ...</code>. The path of trajectory <code>t</code> is
+     *         runs <code>runs.offsets[t]</code> to <code>runs.offsets[t + 1] - 1</code>, entered
+     *         at <code>runs.entryTimes</code>.
+     */
+    public double[] cellRunsToPath(CellRuns runs) {
+        return h3ToGeo(runs.cells);
+    }
+
+    /**
+     * Adds the cells of the line between two cells, not including them, with times
+     * interpolated between theirs.
+     *
+     * @return Number of runs after those added
+     */
+    private int fillGap(long start, long end, long startTime, long endTime, long[] cells, long[] times, int size) {
+        List<Long> line;
+        try {
+            line = h3Line(start, end);
+        } catch (LineUndefinedException e) {
+            return size;
+        }
+        int steps = line.size() - 1;
+        for (int i = 1; i < steps; i++) {
+            cells[size] = line.get(i);
+            times[size] = startTime + (endTime - startTime) * i / steps;
+            size++;
+        }
+        return size;
+    }
+
     /**
      * Finds indexes within the given geofence.
      *
@@ -656,6 +998,9 @@ public class H3Core {
     /**
      * Finds indexes within the given geofence.
      *
+     * <p>Geofences with many vertices are filled using a {@link PreparedGeoPolygon},
+     * which finds the same cells but only tests the edges near each cell.
+     *
      * @param points Outline geofence
      * @param holes Geofences of any internal holes
      * @param res Resolution of the desired indexes
@@ -664,35 +1009,250 @@ public class H3Core {
     public List<Long> polyfill(List<GeoCoord> points, List<List<GeoCoord>> holes, int res) {
         checkResolution(res);
 
-        // pack the data for use by the polyfill JNI call
-        double[] verts = new double[points.size() * 2];
-        packGeofenceVertices(verts, points, 0);
-        int[] holeSizes = new int[0];
-        double[] holeVerts = new double[0];
-        if (holes != null) {
-            holeSizes = new int[holes.size()];
-            int totalSize = 0;
-            for (int i = 0; i < holes.size(); i++) {
-                totalSize += holes.get(i).size() * 2;
-                // Note we are storing the number of doubles
-                holeSizes[i] = holes.get(i).size() * 2;
-            }
-            holeVerts = new double[totalSize];
-            int offset = 0;
-            for (int i = 0; i < holes.size(); i++) {
-                offset = packGeofenceVertices(holeVerts, holes.get(i), offset);
+        PackedPolygon packed = new PackedPolygon(points, holes);
+
+        if (packed.numVerts() >= PREPARED_POLYFILL_MIN_VERTS) {
+            try (PreparedGeoPolygon prepared = preparePolygon(packed)) {
+                return prepared.polyfill(res);
             }
         }
 
-        int sz = h3Api.maxPolyfillSize(verts, holeSizes, holeVerts, res);
+        int sz = h3Api.maxPolyfillSize(packed.verts, packed.holeSizes, packed.holeVerts, res);
 
         long[] results = new long[sz];
 
-        h3Api.polyfill(verts, holeSizes, holeVerts, res, results);
+        h3Api.polyfill(packed.verts, packed.holeSizes, packed.holeVerts, res, results);
 
         return nonZeroLongArrayToList(results);
     }
 
+    /**
+     * Finds indexes within each of the given polygons, using one native call and all
+     * available processors.
+     *
+     * @see #polyfillBatch(double[], int[], int[], int, int)
+     */
+    public GroupedCells polyfillBatch(double[] verts, int[] ringOffsets, int[] polygonOffsets, int res) {
+        return polyfillBatch(verts, ringOffsets, polygonOffsets, res, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Finds indexes within each of the given polygons, using one native call. Polygons
+     * are filled in parallel on native threads.
+     *
+     * <p>Ring <code>r</code> has the vertices <code>ringOffsets[r]</code> to
+     * <code>ringOffsets[r + 1] - 1</code>. Polygon <code>p</code> has the rings
+     * <code>polygonOffsets[p]</code> to <code>polygonOffsets[p + 1] - 1</code>, of
+     * which the first is the outline and the rest are holes.
+     *
+     * @param verts Interleaved latitudes and longitudes of all vertices, in degrees
+     * @param ringOffsets Index of the first vertex of each ring, followed by the number of vertices
+     * @param polygonOffsets Index of the first ring of each polygon, followed by the number of rings
+     * @param res Resolution of the desired indexes
+     * @param numThreads Maximum number of threads to use
+     * @return Cells for each polygon, in the order the polygons were given
+     * @throws IllegalArgumentException Invalid resolution, or offsets out of range
+     */
+    public GroupedCells polyfillBatch(double[] verts, int[] ringOffsets, int[] polygonOffsets, int res,
+                                      int numThreads) {
+        checkResolution(res);
+        checkOffsets(ringOffsets, checkLatLngs(verts), "ringOffsets");
+        checkOffsets(polygonOffsets, ringOffsets.length - 1, "polygonOffsets");
+        checkNumThreads(numThreads);
+
+        int[] resultOffsets = new int[polygonOffsets.length];
+        long[] cells = h3Api.polyfillBatch(toRadiansArray(verts), ringOffsets, polygonOffsets, res, numThreads,
+                resultOffsets);
+        return new GroupedCells(cells, resultOffsets);
+    }
+
+    /**
+     * Finds indexes whose centers are within the given latitude and longitude box.
+     *
+     * <p>This does not construct a polygon, and tests each cell center directly against
+     * the box. If <code>west</code> is greater than <code>east</code>, the box crosses
+     * the antimeridian.
+     *
+     * @param south Southern edge latitude in degrees
+     * @param west Western edge longitude in degrees
+     * @param north Northern edge latitude in degrees
+     * @param east Eastern edge longitude in degrees
+     * @param res Resolution of the desired indexes
+     * @throws IllegalArgumentException Invalid resolution, or coordinates out of range
+     */
+    public List<Long> polyfillBBox(double south, double west, double north, double east, int res) {
+        checkResolution(res);
+        if (!(south >= -90 && north <= 90 && south <= north)) {
+            throw new IllegalArgumentException("Latitudes must be -90 <= south <= north <= 90");
+        }
+        if (!(west >= -180 && west <= 180 && east >= -180 && east <= 180)) {
+            throw new IllegalArgumentException("Longitudes must be between -180 and 180");
+        }
+
+        return nonZeroLongArrayToList(h3Api.polyfillBBox(toRadians(south), toRadians(west), toRadians(north),
+                toRadians(east), res));
+    }
+
+    /**
+     * Finds indexes whose centers are within the given great circle distance of a point.
+     *
+     * <p>This does not construct a polygon, and tests the distance to each cell center
+     * directly, as {@link #pointDist(GeoCoord, GeoCoord, LengthUnit)} does.
+     *
+     * @param lat Latitude of the center in degrees
+     * @param lng Longitude of the center in degrees
+     * @param radiusMeters Radius in meters
+     * @param res Resolution of the desired indexes
+     * @throws IllegalArgumentException Invalid resolution, or invalid center or radius
+     */
+    public List<Long> polyfillCircle(double lat, double lng, double radiusMeters, int res) {
+        checkResolution(res);
+        if (!(Double.isFinite(lat) && Double.isFinite(lng))) {
+            throw new IllegalArgumentException("Latitude or longitude were invalid.");
+        }
+        if (!(radiusMeters >= 0 && radiusMeters < Double.POSITIVE_INFINITY)) {
+            throw new IllegalArgumentException("radiusMeters must be finite and non-negative");
+        }
+
+        return nonZeroLongArrayToList(h3Api.polyfillCircle(toRadians(lat), toRadians(lng), radiusMeters, res));
+    }
+
+    /**
+     * Finds the indexes the polyline passes through, in the order they are first
+     * visited. Each segment is the great circle arc between consecutive points.
+     *
+     * @see #polylineToCells(double[], int, double, int)
+     */
+    public long[] polylineToCells(double[] latLngs, int res) {
+        return polylineToCells(latLngs, res, 0, 0);
+    }
+
+    /**
+     * Finds the indexes the polyline passes through, in the order they are first
+     * visited, by following the line from cell to cell across their edges.
+     *
+     * <p>Unlike {@link #h3Line(long, long)}, which connects the cells containing the
+     * end points, every cell the line passes through is included, however briefly.
+     *
+     * @param latLngs Interleaved latitudes and longitudes of the points, in degrees
+     * @param res Resolution of the desired indexes
+     * @param densifyMeters If positive, each segment is instead straight in latitude and
+     *                      longitude, as it would be drawn on a flat map, and is followed
+     *                      as great circle arcs of at most this length. If zero, each
+     *                      segment is a great circle arc.
+     * @param k If positive, indexes within <code>k</code> steps of the path are added after
+     *          those on the path.
+     * @throws IllegalArgumentException Invalid resolution, parameters or coordinates, or the cells
+     * along a segment are not defined, as its ends are antipodal or the line between cells could not
+     * be found
+     */
+    public long[] polylineToCells(double[] latLngs, int res, double densifyMeters, int k) {
+        return polylineToCellsBatch(latLngs, new int[] {0, latLngs.length / 2}, res, densifyMeters, k, 1).group(0);
+    }
+
+    /**
+     * Finds the indexes each of the given polylines pass through, using one native call
+     * and all available processors.
+     *
+     * @see #polylineToCellsBatch(double[], int[], int, double, int, int)
+     */
+    public GroupedCells polylineToCellsBatch(double[] latLngs, int[] lineOffsets, int res, double densifyMeters,
+                                             int k) {
+        return polylineToCellsBatch(latLngs, lineOffsets, res, densifyMeters, k,
+                Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Finds the indexes each of the given polylines pass through, using one native call.
+     * Polylines are followed in parallel on native threads.
+     *
+     * <p>Polyline <code>l</code> has the points <code>lineOffsets[l]</code> to
+     * <code>lineOffsets[l + 1] - 1</code>.
+     *
+     * @param latLngs Interleaved latitudes and longitudes of all points, in degrees
+     * @param lineOffsets Index of the first point of each polyline, followed by the number of points
+     * @param res Resolution of the desired indexes
+     * @param densifyMeters See {@link #polylineToCells(double[], int, double, int)}
+     * @param k See {@link #polylineToCells(double[], int, double, int)}
+     * @param numThreads Maximum number of threads to use
+     * @return Cells for each polyline, in the order the polylines were given
+     * @throws IllegalArgumentException Invalid resolution, parameters or coordinates, offsets out
+     * of range, or the cells along a segment are not defined
+     */
+    public GroupedCells polylineToCellsBatch(double[] latLngs, int[] lineOffsets, int res, double densifyMeters,
+                                             int k, int numThreads) {
+        checkResolution(res);
+        checkOffsets(lineOffsets, checkLatLngs(latLngs), "lineOffsets");
+        checkFinite(latLngs);
+        if (!(densifyMeters >= 0 && densifyMeters < Double.POSITIVE_INFINITY)) {
+            throw new IllegalArgumentException("densifyMeters must be finite and non-negative");
+        }
+        if (k < 0) {
+            throw new IllegalArgumentException("k must be non-negative");
+        }
+        checkNumThreads(numThreads);
+
+        int[] resultOffsets = new int[lineOffsets.length];
+        long[] cells = h3Api.polylineToCellsBatch(toRadiansArray(latLngs), lineOffsets, res, densifyMeters, k,
+                numThreads, resultOffsets);
+        return new GroupedCells(cells, resultOffsets);
+    }
+
+    /**
+     * Indexes the edges of the given geofence, for repeated use with
+     * {@link PreparedGeoPolygon#polyfill(int)} and {@link PreparedGeoPolygon#contains(double, double)}.
+     * The returned polygon holds native memory until it is closed.
+     *
+     * @param points Outline geofence
+     * @param holes Geofences of any internal holes
+     */
+    public PreparedGeoPolygon preparePolygon(List<GeoCoord> points, List<List<GeoCoord>> holes) {
+        return preparePolygon(new PackedPolygon(points, holes));
+    }
+
+    private PreparedGeoPolygon preparePolygon(PackedPolygon packed) {
+        long polygon = h3Api.createPreparedPolygon(packed.verts, packed.holeSizes, packed.holeVerts);
+        return new PreparedGeoPolygon(h3Api, polygon);
+    }
+
+    /**
+     * A geofence and its holes, packed for use by the polyfill JNI calls.
+     */
+    private static final class PackedPolygon {
+        final double[] verts;
+        final int[] holeSizes;
+        final double[] holeVerts;
+
+        PackedPolygon(List<GeoCoord> points, List<List<GeoCoord>> holes) {
+            verts = new double[points.size() * 2];
+            packGeofenceVertices(verts, points, 0);
+            if (holes != null) {
+                holeSizes = new int[holes.size()];
+                int totalSize = 0;
+                for (int i = 0; i < holes.size(); i++) {
+                    totalSize += holes.get(i).size() * 2;
+                    // Note we are storing the number of doubles
+                    holeSizes[i] = holes.get(i).size() * 2;
+                }
+                holeVerts = new double[totalSize];
+                int offset = 0;
+                for (int i = 0; i < holes.size(); i++) {
+                    offset = packGeofenceVertices(holeVerts, holes.get(i), offset);
+                }
+            } else {
+                holeSizes = new int[0];
+                holeVerts = new double[0];
+            }
+        }
+
+        /**
+         * Total number of vertices in the geofence and its holes.
+         */
+        int numVerts() {
+            return (verts.length + holeVerts.length) / 2;
+        }
+    }
+
     /**
      * Interleave the pairs in the given double array.
      *
@@ -722,14 +1282,117 @@ public class H3Core {
 
     /**
      * Create polygons from a set of contiguous indexes
+     *
+     * <p>The indexes may be of mixed resolutions, as from {@link #compact(Collection)}.
+     * In that case the outline is the same as that of the set uncompacted to its finest
+     * resolution, but only indexes along the edges of the set are uncompacted.
      */
     public List<List<List<GeoCoord>>> h3SetToMultiPolygon(Collection<Long> h3, boolean geoJson) {
         long[] h3AsArray = collectionToLongArray(h3);
 
         ArrayList<List<List<GeoCoord>>> result = new ArrayList<>();
 
-        h3Api.h3SetToLinkedGeo(h3AsArray, result);
+        if (hasMixedResolutions(h3AsArray)) {
+            h3Api.compactedSetToLinkedGeo(h3AsArray, result);
+        } else {
+            h3Api.h3SetToLinkedGeo(h3AsArray, result);
+        }
+
+        return linkedGeoToDegrees(result, geoJson);
+    }
+
+    /**
+     * Create simplified polygons from a set of contiguous indexes, which may be of
+     * mixed resolutions.
+     *
+     * <p>The outline is simplified natively with the Douglas-Peucker algorithm, which
+     * removes vertices that are within <code>toleranceMeters</code> of the simplified
+     * outline. Vertices where polygons or holes touch are always kept, so they still
+     * touch at the same points. The tolerance should be small compared to the width
+     * of the region, as simplification can otherwise cause loops to cross.
+     *
+     * @param h3 Indexes to outline
+     * @param geoJson Whether to close each loop by repeating its first vertex
+     * @param toleranceMeters Maximum distance of removed vertices from the simplified
+     *                        outline. Zero removes only vertices in a straight line.
+     * @throws IllegalArgumentException Invalid tolerance
+     * @see #h3SetToMultiPolygon(Collection, boolean)
+     */
+    public List<List<List<GeoCoord>>> h3SetToMultiPolygon(Collection<Long> h3, boolean geoJson,
+                                                          double toleranceMeters) {
+        if (!(toleranceMeters >= 0 && toleranceMeters < Double.POSITIVE_INFINITY)) {
+            throw new IllegalArgumentException("toleranceMeters must be finite and non-negative");
+        }
+
+        ArrayList<List<List<GeoCoord>>> result = new ArrayList<>();
+
+        h3Api.h3SetToSimplifiedLinkedGeo(collectionToLongArray(h3), toleranceMeters, result);
+
+        return linkedGeoToDegrees(result, geoJson);
+    }
 
+    /**
+     * Creates an empty outline, which is updated as indexes are added to and removed
+     * from it, for sets which change a few indexes at a time.
+     */
+    public DynamicOutline newDynamicOutline() {
+        return new DynamicOutline(this);
+    }
+
+    /**
+     * Creates an executor which fills batches of polygons on the given pool, splitting
+     * large polygons into tiles so that the pool stays busy.
+     *
+     * @param pool Pool to run the tasks on, such as {@link ForkJoinPool#commonPool()}
+     */
+    public PolyfillExecutor newPolyfillExecutor(ForkJoinPool pool) {
+        return new PolyfillExecutor(this, pool);
+    }
+
+    /**
+     * Creates an aggregator of events per index over a sliding window of time, made of
+     * <code>numBuckets</code> buckets of <code>bucketMillis</code> each.
+     *
+     * @param res Resolution of the indexes events are counted in
+     * @param bucketMillis Length of each bucket, in milliseconds
+     * @param numBuckets Number of buckets in the window
+     * @throws IllegalArgumentException Invalid resolution, or bucketMillis or numBuckets is less than 1
+     */
+    public SlidingWindowAggregator newSlidingWindowAggregator(int res, long bucketMillis, int numBuckets) {
+        return new SlidingWindowAggregator(this, res, bucketMillis, numBuckets);
+    }
+
+    /**
+     * Creates a tracker of entities entering and exiting geofences, indexing positions at
+     * resolution <code>res</code>.
+     *
+     * @param fences Cells of each geofence, such as from <code>compact</code>, of resolution
+     *               <code>res</code> or coarser
+     * @param res Resolution positions are indexed at
+     * @throws IllegalArgumentException Invalid resolution, or a geofence cell is finer than it
+     */
+    public GeofenceTracker newGeofenceTracker(GroupedCells fences, int res) {
+        return new GeofenceTracker(this, fences, res);
+    }
+
+    /**
+     * Creates an aggregator of trips into counts per origin and destination cell of
+     * resolution <code>res</code>.
+     *
+     * @param res Resolution of the origin and destination cells
+     * @param countEdges Whether to also count traversals of each unidirectional edge along
+     *                   the line between the origin and destination of each trip
+     * @throws IllegalArgumentException Invalid resolution
+     */
+    public FlowAggregator newFlowAggregator(int res, boolean countEdges) {
+        return new FlowAggregator(this, res, countEdges);
+    }
+
+    /**
+     * Converts polygons from h3SetToLinkedGeo to degrees, in place.
+     */
+    private static List<List<List<GeoCoord>>> linkedGeoToDegrees(List<List<List<GeoCoord>>> result,
+                                                                 boolean geoJson) {
         // For each polygon
         for (List<List<GeoCoord>> loops : result) {
             // For each loop within the polygon (first being the outline,
@@ -757,6 +1420,203 @@ public class H3Core {
         return result;
     }
 
+    /**
+     * Finds the boundaries of the given indexes as a mesh, with each vertex shared
+     * by neighboring indexes stored once, rather than repeated in each index's
+     * boundary as from {@link #h3ToGeoBoundary(long)}.
+     *
+     * @param h3 Indexes to find the boundaries of. Invalid indexes have an empty boundary.
+     * @return Mesh with one boundary for each of the indexes, in order
+     */
+    public CellMesh cellsToMesh(long[] h3) {
+        int[] offsets = new int[h3.length + 1];
+        int[] indices = new int[h3.length * MAX_CELL_BNDRY_VERTS];
+        double[] vertices = h3Api.cellsToMesh(h3, offsets, indices);
+        for (int i = 0; i < vertices.length; i++) {
+            vertices[i] = toDegrees(vertices[i]);
+        }
+        return new CellMesh(vertices, offsets, Arrays.copyOf(indices, offsets[h3.length]));
+    }
+
+    /**
+     * Finds the bounding box of each of the indexes in one native call, such as for
+     * loading into an R-tree.
+     *
+     * <p>The box of <code>h3[i]</code> is <code>out[4 * i]</code> to <code>out[4 * i + 3]</code>:
+     * the south, west, north, and east bounds, in degrees. The edges of an index are great
+     * circle arcs, so the box includes the latitudes an edge reaches between its vertices. For
+     * an index crossing the antimeridian, west is greater than east. For an index containing a
+     * pole, the box extends to the pole, from west -180 to east 180. The box of the invalid
+     * index is NaN.
+     *
+     * @param h3 Indexes to find the boxes of
+     * @param out Output, of length at least <code>4 * h3.length</code>
+     * @throws IllegalArgumentException out is too short
+     */
+    public void cellBBox(long[] h3, double[] out) {
+        checkBBoxOutput(h3, out);
+        h3Api.cellBBox(h3, out);
+        for (int i = 0; i < h3.length * 4; i++) {
+            out[i] = toDegrees(out[i]);
+        }
+    }
+
+    /**
+     * Finds the bounding box of the parent of each of the indexes at
+     * <code>parentRes</code>, in the form of {@link #cellBBox(long[], double[])}, for coarse
+     * filtering. Boxes of resolution 0 parents are kept in a table after first use, and the
+     * box of a parent shared by consecutive indexes is only found once.
+     *
+     * <p>As for {@link #cellBBox(long[], double[])}, the box of an invalid parent is NaN. This
+     * includes the parent of the invalid index, of an index with an invalid base cell, and of
+     * an index coarser than <code>parentRes</code>. Indexes are not otherwise validated.
+     *
+     * @param h3 Indexes to find the parent boxes of
+     * @param parentRes Resolution of the parents
+     * @param out Output, of length at least <code>4 * h3.length</code>
+     * @throws IllegalArgumentException out is too short, or parentRes is invalid
+     */
+    public void cellParentBBox(long[] h3, int parentRes, double[] out) {
+        checkResolution(parentRes);
+        checkBBoxOutput(h3, out);
+        if (parentRes == 0) {
+            double[] table = res0BBoxes();
+            for (int i = 0; i < h3.length; i++) {
+                int baseCell = (int) ((h3[i] & H3_BC_MASK) >> H3_BC_OFFSET);
+                if (h3[i] == INVALID_INDEX || baseCell >= NUM_BASE_CELLS) {
+                    Arrays.fill(out, i * 4, i * 4 + 4, Double.NaN);
+                } else {
+                    System.arraycopy(table, baseCell * 4, out, i * 4, 4);
+                }
+            }
+            return;
+        }
+
+        // Position of the distinct parent for each index
+        int[] parentIndex = new int[h3.length];
+        long[] parents = new long[h3.length];
+        int numParents = 0;
+        for (int i = 0; i < h3.length; i++) {
+            long parent = h3GetResolution(h3[i]) < parentRes ? INVALID_INDEX : h3ToParent(h3[i], parentRes);
+            if (numParents == 0 || parents[numParents - 1] != parent) {
+                parents[numParents++] = parent;
+            }
+            parentIndex[i] = numParents - 1;
+        }
+
+        double[] parentBoxes = new double[numParents * 4];
+        cellBBox(Arrays.copyOf(parents, numParents), parentBoxes);
+        for (int i = 0; i < h3.length; i++) {
+            System.arraycopy(parentBoxes, parentIndex[i] * 4, out, i * 4, 4);
+        }
+    }
+
+    private double[] res0BBoxes() {
+        double[] table = res0BBoxes;
+        if (table == null) {
+            // Resolution 0 indexes are in order of base cell
+            long[] res0 = new long[NUM_BASE_CELLS];
+            h3Api.getRes0Indexes(res0);
+            table = new double[NUM_BASE_CELLS * 4];
+            cellBBox(res0, table);
+            res0BBoxes = table;
+        }
+        return table;
+    }
+
+    /**
+     * Projects the center of each of the indexes onto a plane tangent to the sphere at the
+     * origin, in one native call, for planar geometry in meters.
+     *
+     * @param h3 Indexes to project the centers of
+     * @param originLat Latitude of the origin, in degrees
+     * @param originLng Longitude of the origin, in degrees
+     * @param projection Projection onto the plane
+     * @return Interleaved x (east) and y (north) of each center, in meters. The center of the
+     *         invalid index is NaN.
+     */
+    public double[] cellCentersToPlanar(long[] h3, double originLat, double originLng, PlanarProjection projection) {
+        double[] out = new double[h3.length * 2];
+        if (h3.length > 0) {
+            h3Api.cellCentersToPlanar(h3, toRadians(originLat), toRadians(originLng), projection.ordinal(), out, null);
+        }
+        return out;
+    }
+
+    /**
+     * Projects the center of each of the indexes as in
+     * {@link #cellCentersToPlanar(long[], double, double, PlanarProjection)}, to a compact
+     * float array.
+     */
+    public float[] cellCentersToPlanarFloat(long[] h3, double originLat, double originLng,
+                                            PlanarProjection projection) {
+        float[] out = new float[h3.length * 2];
+        if (h3.length > 0) {
+            h3Api.cellCentersToPlanar(h3, toRadians(originLat), toRadians(originLng), projection.ordinal(), null, out);
+        }
+        return out;
+    }
+
+    /**
+     * Projects the boundary of each of the indexes onto a plane tangent to the sphere at the
+     * origin, in one native call, for planar geometry in meters.
+     *
+     * <p>The boundary of <code>h3[i]</code> is the vertices <code>offsets[i]</code> to
+     * <code>offsets[i + 1] - 1</code>, counter-clockwise.
+     *
+     * @param h3 Indexes to project the boundaries of
+     * @param originLat Latitude of the origin, in degrees
+     * @param originLng Longitude of the origin, in degrees
+     * @param projection Projection onto the plane
+     * @param offsets Output, of length at least <code>h3.length + 1</code>, for the first vertex
+     *                of each boundary followed by the number of vertices
+     * @return Interleaved x (east) and y (north) of each vertex, in meters. The invalid index
+     *         has no vertices.
+     * @throws IllegalArgumentException offsets is too short
+     */
+    public double[] cellBoundariesToPlanar(long[] h3, double originLat, double originLng, PlanarProjection projection,
+                                           int[] offsets) {
+        checkBoundaryOffsets(h3, offsets);
+        double[] out = new double[h3.length * MAX_CELL_BNDRY_VERTS * 2];
+        if (h3.length > 0) {
+            h3Api.cellBoundariesToPlanar(h3, toRadians(originLat), toRadians(originLng), projection.ordinal(), offsets,
+                    out, null);
+        }
+        return Arrays.copyOf(out, offsets[h3.length] * 2);
+    }
+
+    /**
+     * Projects the boundary of each of the indexes as in
+     * {@link #cellBoundariesToPlanar(long[], double, double, PlanarProjection, int[])}, to a
+     * compact float array.
+     */
+    public float[] cellBoundariesToPlanarFloat(long[] h3, double originLat, double originLng,
+                                               PlanarProjection projection, int[] offsets) {
+        checkBoundaryOffsets(h3, offsets);
+        float[] out = new float[h3.length * MAX_CELL_BNDRY_VERTS * 2];
+        if (h3.length > 0) {
+            h3Api.cellBoundariesToPlanar(h3, toRadians(originLat), toRadians(originLng), projection.ordinal(), offsets,
+                    null, out);
+        }
+        return Arrays.copyOf(out, offsets[h3.length] * 2);
+    }
+
+    private static void checkBoundaryOffsets(long[] h3, int[] offsets) {
+        if (offsets.length < h3.length + 1) {
+            throw new IllegalArgumentException(String.format(
+                    "offsets (length %d) must have room for one more than the number of indexes (%d)",
+                    offsets.length, h3.length));
+        }
+        offsets[h3.length] = 0;
+    }
+
+    private static void checkBBoxOutput(long[] h3, double[] out) {
+        if (out.length < h3.length * 4) {
+            throw new IllegalArgumentException(String.format(
+                    "out (length %d) must have room for 4 values per index (%d)", out.length, h3.length * 4));
+        }
+    }
+
     /**
      * Returns the resolution of the provided index
      */
@@ -798,6 +1658,35 @@ public class H3Core {
         return (h3 & H3_RES_MASK_NEGATIVE) | newRes | digitMaskForRes;
     }
 
+    /**
+     * Returns the parent of each index at the given resolution, using all available
+     * processors.
+     *
+     * @see #h3ToParent(long[], int, int)
+     */
+    public long[] h3ToParent(long[] h3, int res) {
+        return h3ToParent(h3, res, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Returns the parent of each index at the given resolution, using a single native call.
+     * Large arrays are split across native threads.
+     *
+     * @param h3 Indexes to find the parents of
+     * @param res Resolution of the parents
+     * @param numThreads Maximum number of threads to use
+     * @return Parent of each index. The parent of an invalid index, or of an index coarser
+     *         than <code>res</code>, is the invalid index, 0.
+     * @throws IllegalArgumentException Invalid resolution, or numThreads is less than 1
+     */
+    public long[] h3ToParent(long[] h3, int res, int numThreads) {
+        checkResolution(res);
+        checkNumThreads(numThreads);
+        long[] out = new long[h3.length];
+        h3Api.h3ToParentBatch(h3, res, numThreads, out);
+        return out;
+    }
+
     /**
      * Returns the parent of the index at the given resolution.
      *
@@ -837,6 +1726,28 @@ public class H3Core {
         return nonZeroLongArrayToList(out);
     }
 
+    /**
+     * Returns the children of each of the indexes at the given resolution, in order.
+     */
+    long[] h3ToChildren(long[] h3, int childRes) {
+        long[] out = new long[0];
+        int size = 0;
+        for (long parent : h3) {
+            int sz = h3Api.maxH3ToChildrenSize(parent, childRes);
+            if (out.length < size + sz) {
+                out = Arrays.copyOf(out, Math.max(out.length * 2, size + sz));
+            }
+            long[] children = new long[sz];
+            h3Api.h3ToChildren(parent, childRes, children);
+            for (long child : children) {
+                if (child != 0) {
+                    out[size++] = child;
+                }
+            }
+        }
+        return Arrays.copyOf(out, size);
+    }
+
     /**
      * Returns the center child at the given resolution.
      *
@@ -920,6 +1831,33 @@ public class H3Core {
         return nonZeroLongArrayToList(out);
     }
 
+    /**
+     * Returns a compacted set of indexes, without boxing them.
+     *
+     * @throws IllegalArgumentException Invalid input, such as duplicated indexes.
+     */
+    long[] compact(long[] h3) {
+        long[] out = new long[h3.length];
+        if (h3Api.compact(h3, out) != 0) {
+            throw new IllegalArgumentException("Bad input to compact");
+        }
+
+        int size = 0;
+        for (long cell : out) {
+            if (cell != 0) {
+                size++;
+            }
+        }
+        long[] result = new long[size];
+        int i = 0;
+        for (long cell : out) {
+            if (cell != 0) {
+                result[i++] = cell;
+            }
+        }
+        return result;
+    }
+
     /**
      * Uncompacts all the given indexes to resolution <code>res</code>.
      */
@@ -952,6 +1890,26 @@ public class H3Core {
         return nonZeroLongArrayToList(out);
     }
 
+    /**
+     * Aggregates the values of a set of indexes to each coarser resolution down to
+     * <code>minRes</code>, and finds the compacted coverage of each resolution, for serving
+     * the same data at many zoom levels.
+     *
+     * <p>All levels are built in one pass from the finest resolution to the coarsest, using
+     * {@link #h3ToParent(long, int)} on sorted arrays, and are returned in one set of columns.
+     *
+     * @param h3 Indexes of one resolution. The values of duplicates are combined.
+     * @param values Value of each index
+     * @param minRes Coarsest resolution to aggregate to
+     * @param aggregation How the values of child indexes are combined
+     * @return Each level, from <code>minRes</code> to the resolution of the indexes
+     * @throws IllegalArgumentException The indexes are of more than one resolution, the arrays
+     *         differ in length, or minRes is invalid or finer than the indexes
+     */
+    public CellPyramid buildPyramid(long[] h3, double[] values, int minRes, Aggregation aggregation) {
+        return CellPyramidBuilder.build(this, h3, values, minRes, aggregation);
+    }
+
     /**
      * Converts from <code>long</code> representation of an index to <code>String</code> representation.
      */
@@ -995,6 +1953,36 @@ public class H3Core {
             throw new IllegalArgumentException(String.format("Invalid unit: %s", unit));
     }
 
+    /**
+     * Calculates the area of each of the given cells, using all available processors.
+     *
+     * @see #cellArea(long[], AreaUnit, int)
+     */
+    public double[] cellArea(long[] h3, AreaUnit unit) {
+        return cellArea(h3, unit, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Calculates the area of each of the given cells, using a single native call. Large
+     * arrays are split across native threads.
+     *
+     * @param h3 Cells to find the areas of
+     * @param unit Unit to return the areas in
+     * @param numThreads Maximum number of threads to use
+     * @return Area of each cell. The area of an invalid index is 0.
+     * @throws IllegalArgumentException numThreads is less than 1
+     */
+    public double[] cellArea(long[] h3, AreaUnit unit, int numThreads) {
+        if (unit == null) {
+            throw new IllegalArgumentException("Invalid unit: null");
+        }
+        checkNumThreads(numThreads);
+        double[] out = new double[h3.length];
+        // The native units are in the same order as AreaUnit
+        h3Api.cellAreaBatch(h3, unit.ordinal(), numThreads, out);
+        return out;
+    }
+
     /**
      * Return the distance along the sphere between two points.
      *
@@ -1268,6 +2256,153 @@ public class H3Core {
         return getH3UnidirectionalEdgeBoundary(stringToH3(h3));
     }
 
+    /**
+     * Finds the boundary of a set of indexes in one native call: the unidirectional
+     * edges leaving the set, the indexes in the set with a neighbor outside it, and
+     * the indexes outside the set with a neighbor in it.
+     *
+     * @param h3 Indexes of one resolution. Invalid indexes and duplicates are ignored.
+     * @return Each part of the boundary, in the order found visiting the input in order
+     * @throws IllegalArgumentException The indexes are of more than one resolution
+     */
+    public RegionBoundary boundaryEdges(long[] h3) {
+        if (hasMixedResolutions(h3)) {
+            throw new IllegalArgumentException("Indexes must all be of the same resolution");
+        }
+
+        int[] offsets = new int[4];
+        long[] results = h3Api.regionBoundary(h3, offsets);
+        return new RegionBoundary(
+                Arrays.copyOfRange(results, offsets[0], offsets[1]),
+                Arrays.copyOfRange(results, offsets[1], offsets[2]),
+                Arrays.copyOfRange(results, offsets[2], offsets[3]));
+    }
+
+    /**
+     * Finds the indexes within <code>k</code> grid steps of a set of indexes, including the
+     * set itself. This is the union of <code>kRing(h3[i], k)</code>, but is found by
+     * expanding outward from the edge of the set, in one native call using all available
+     * processors.
+     *
+     * @param h3 Indexes of one resolution. Invalid indexes and duplicates are ignored.
+     * @param k Number of grid steps to expand by
+     * @return The expanded set, sorted
+     * @throws IllegalArgumentException The indexes are of more than one resolution, or k is negative
+     */
+    public long[] dilateCells(long[] h3, int k) {
+        return cellMorphology(h3, MORPHOLOGY_DILATE, k);
+    }
+
+    /**
+     * Finds the indexes of a set which are more than <code>k</code> grid steps from any index
+     * outside it. This shrinks the set inward from its edge, in one native call using all
+     * available processors.
+     *
+     * @param h3 Indexes of one resolution. Invalid indexes and duplicates are ignored.
+     * @param k Number of grid steps to shrink by
+     * @return The shrunk set, sorted
+     * @throws IllegalArgumentException The indexes are of more than one resolution, or k is negative
+     */
+    public long[] erodeCells(long[] h3, int k) {
+        return cellMorphology(h3, MORPHOLOGY_ERODE, k);
+    }
+
+    /**
+     * Erodes and then dilates a set of indexes by <code>k</code>, removing parts of the set
+     * narrower than about <code>2 * k + 1</code> indexes while keeping the shape of the rest.
+     *
+     * @see #erodeCells(long[], int)
+     * @see #dilateCells(long[], int)
+     */
+    public long[] openCells(long[] h3, int k) {
+        return cellMorphology(h3, MORPHOLOGY_OPEN, k);
+    }
+
+    /**
+     * Dilates and then erodes a set of indexes by <code>k</code>, filling gaps and holes in
+     * the set narrower than about <code>2 * k + 1</code> indexes while keeping the shape of
+     * the rest.
+     *
+     * @see #dilateCells(long[], int)
+     * @see #erodeCells(long[], int)
+     */
+    public long[] closeCells(long[] h3, int k) {
+        return cellMorphology(h3, MORPHOLOGY_CLOSE, k);
+    }
+
+    private long[] cellMorphology(long[] h3, int operation, int k) {
+        if (hasMixedResolutions(h3)) {
+            throw new IllegalArgumentException("Indexes must all be of the same resolution");
+        }
+        if (k < 0) {
+            throw new IllegalArgumentException("k must be non-negative");
+        }
+        return h3Api.cellMorphology(h3, operation, k, Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Finds the connected components of a set of indexes, where indexes sharing an edge
+     * are connected.
+     *
+     * @param h3 Indexes of one resolution. Invalid indexes and duplicates are ignored.
+     * @return Indexes of each component, in the order the components are first reached
+     *         visiting the input in order
+     * @throws IllegalArgumentException The indexes are of more than one resolution
+     */
+    public GroupedCells connectedComponents(long[] h3) {
+        return cellComponents(h3, 1);
+    }
+
+    /**
+     * Removes the connected components of a set of indexes with fewer than
+     * <code>minSize</code> indexes.
+     *
+     * @param h3 Indexes of one resolution. Invalid indexes and duplicates are ignored.
+     * @param minSize Minimum number of indexes in a component to keep it
+     * @return The remaining indexes, sorted
+     * @throws IllegalArgumentException The indexes are of more than one resolution
+     * @see #connectedComponents(long[])
+     */
+    public long[] removeSmallComponents(long[] h3, int minSize) {
+        long[] cells = cellComponents(h3, Math.max(minSize, 1)).cells;
+        Arrays.sort(cells);
+        return cells;
+    }
+
+    private GroupedCells cellComponents(long[] h3, int minSize) {
+        if (hasMixedResolutions(h3)) {
+            throw new IllegalArgumentException("Indexes must all be of the same resolution");
+        }
+        long[] results = new long[h3.length];
+        int[] offsets = h3Api.cellComponents(h3, minSize, results);
+        return new GroupedCells(Arrays.copyOf(results, offsets[offsets.length - 1]), offsets);
+    }
+
+    /**
+     * Adds the holes in a set of indexes with at most <code>maxHoleSize</code> indexes to it.
+     * A hole is a connected region of indexes outside the set which the set surrounds.
+     *
+     * <p>The holes are found natively by flood filling outward from the edge of the set, and
+     * a fill stops once it is larger than <code>maxHoleSize</code>, so this does not depend on
+     * the area around the set. If the area outside the set is itself no larger than
+     * <code>maxHoleSize</code>, it is also filled.
+     *
+     * @param h3 Indexes of one resolution. Invalid indexes and duplicates are ignored.
+     * @param maxHoleSize Maximum number of indexes in a hole to fill it
+     * @return The filled set, sorted
+     * @throws IllegalArgumentException The indexes are of more than one resolution, or
+     *         maxHoleSize is negative
+     */
+    public long[] fillHoles(long[] h3, int maxHoleSize) {
+        if (hasMixedResolutions(h3)) {
+            throw new IllegalArgumentException("Indexes must all be of the same resolution");
+        }
+        if (maxHoleSize < 0) {
+            throw new IllegalArgumentException("maxHoleSize must be non-negative");
+        }
+        return h3Api.fillHoles(h3, maxHoleSize);
+    }
+
     /**
      * Find all icosahedron faces intersected by a given H3 index, represented
      * as integers from 0-19.
@@ -1336,6 +2471,18 @@ public class H3Core {
         return ret;
     }
 
+    /**
+     * Returns true if the indexes are not all of the same resolution.
+     */
+    private boolean hasMixedResolutions(long[] h3) {
+        for (int i = 1; i < h3.length; i++) {
+            if (h3GetResolution(h3[i]) != h3GetResolution(h3[0])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * Returns an array of <code>long</code> with the contents of the collection.
      */
@@ -1343,10 +2490,84 @@ public class H3Core {
         return collection.stream().mapToLong(Long::longValue).toArray();
     }
 
+    /**
+     * Returns a copy of the array with each element converted from degrees to radians.
+     */
+    private static double[] toRadiansArray(double[] degrees) {
+        double[] radians = new double[degrees.length];
+        for (int i = 0; i < degrees.length; i++) {
+            radians[i] = toRadians(degrees[i]);
+        }
+        return radians;
+    }
+
+    private static void toDegreesInPlace(double[] radians, int length) {
+        for (int i = 0; i < length; i++) {
+            radians[i] = toDegrees(radians[i]);
+        }
+    }
+
+    private static void checkNumThreads(int numThreads) {
+        if (numThreads < 1) {
+            throw new IllegalArgumentException("numThreads must be at least 1");
+        }
+    }
+
+    /**
+     * Returns the number of points in an interleaved lat/lng array.
+     *
+     * @throws IllegalArgumentException The array has an odd length.
+     */
+    static int checkLatLngs(double[] latLngs) {
+        if (latLngs.length % 2 != 0) {
+            throw new IllegalArgumentException("Coordinates must be lat/lng pairs, got an odd number of values.");
+        }
+        return latLngs.length / 2;
+    }
+
+    /**
+     * @throws IllegalArgumentException The offsets are empty, decreasing, or outside
+     * <code>0</code> to <code>max</code>.
+     */
+    static void checkOffsets(int[] offsets, int max, String name) {
+        if (offsets.length == 0) {
+            throw new IllegalArgumentException(name + " must have at least one element");
+        }
+        int previous = 0;
+        for (int offset : offsets) {
+            if (offset < previous || offset > max) {
+                throw new IllegalArgumentException(String.format("%s has offset %d out of range", name, offset));
+            }
+            previous = offset;
+        }
+    }
+
+    /**
+     * @throws IllegalArgumentException Any of the coordinates is not finite.
+     */
+    private static void checkFinite(double[] latLngs) {
+        for (double value : latLngs) {
+            if (!Double.isFinite(value)) {
+                throw new IllegalArgumentException("Latitude or longitude were invalid.");
+            }
+        }
+    }
+
+    /**
+     * @throws IllegalArgumentException Any of the results is the invalid index.
+     */
+    private static void checkGeoToH3Results(long[] results) {
+        for (long result : results) {
+            if (result == INVALID_INDEX) {
+                throw new IllegalArgumentException("Latitude or longitude were invalid.");
+            }
+        }
+    }
+
     /**
      * @throws IllegalArgumentException <code>res</code> is not a valid H3 resolution.
      */
-    private static void checkResolution(int res) {
+    static void checkResolution(int res) {
         if (res < 0 || res > 15) {
             throw new IllegalArgumentException(String.format("resolution %d is out of range (must be 0 <= res <= 15)", res));
         }
@@ -41,7 +41,14 @@ public final class H3CoreLoader {
     static final String ARCH_X86 = "x86";
     static final String ARCH_ARM64 = "arm64";
 
+    /**
+     * Name of the library when it is linked statically into a GraalVM native image, which
+     * then provides <code>JNI_OnLoad_h3java</code>.
+     */
+    static final String STATIC_LIBRARY_NAME = "h3java";
+
     private static volatile File libraryFile = null;
+    private static volatile boolean nativeImageLibraryLoaded = false;
 
     /**
      * Read all bytes from <code>in</code> and write them to <code>out</code>.
@@ -116,7 +123,12 @@ public final class H3CoreLoader {
         // This is synchronized because if multiple threads were writing and
         // loading the shared object at the same time, bad things could happen.
 
-        if (libraryFile == null) {
+        if (libraryFile == null && !nativeImageLibraryLoaded) {
+            if (isNativeImage() && loadNativeImageLibrary()) {
+                nativeImageLibraryLoaded = true;
+                return new NativeMethods();
+            }
+
             final String dirName = String.format("%s-%s", os.getDirName(), arch);
             final String libName = String.format("libh3-java%s", os.getSuffix());
 
@@ -124,16 +136,96 @@ public final class H3CoreLoader {
 
             newLibraryFile.deleteOnExit();
 
-            copyResource(String.format("/%s/%s", dirName, libName), newLibraryFile);
+            final String resourcePath = String.format("/%s/%s", dirName, libName);
+            copyResource(resourcePath, newLibraryFile);
 
             System.load(newLibraryFile.getCanonicalPath());
 
             libraryFile = newLibraryFile;
+            registerCheckpointResource();
         }
 
         return new NativeMethods();
     }
 
+    /**
+     * Registers for checkpoint and restore notifications, if CRaC (Coordinated Restore at
+     * Checkpoint) support is on the class path.
+     */
+    private static void registerCheckpointResource() {
+        try {
+            Class.forName("org.crac.Core", false, H3CoreLoader.class.getClassLoader());
+        } catch (ClassNotFoundException | LinkageError e) {
+            return;
+        }
+        LibraryCheckpointResource.register();
+    }
+
+    /**
+     * Deletes the extracted library before a checkpoint. The library stays loaded, so it is
+     * saved in the checkpoint with the rest of the process, rather than referring to a
+     * temporary file which may not exist where the checkpoint is restored.
+     *
+     * <p>The library is not extracted again after a restore: it is mapped into the restored
+     * process as it was, and is never opened from the file again, as later calls to
+     * {@link #loadNatives()} find it already loaded. See {@link #afterRestore()}.
+     */
+    static synchronized void beforeCheckpoint() {
+        if (libraryFile != null) {
+            libraryFile.delete();
+        }
+    }
+
+    /**
+     * Checks that the library saved in the checkpoint can still be called after a restore.
+     *
+     * @throws IllegalStateException The library is not callable in the restored process
+     */
+    static synchronized void afterRestore() {
+        int size;
+        try {
+            size = new NativeMethods().maxKringSize(1);
+        } catch (UnsatisfiedLinkError e) {
+            throw new IllegalStateException("H3 native library is not callable after restore", e);
+        }
+        if (size != 7) {
+            throw new IllegalStateException("H3 native library is not working after restore");
+        }
+    }
+
+    /**
+     * Returns the file the library was extracted to, or null if it was not extracted. The
+     * file no longer exists after a checkpoint.
+     */
+    static File getLibraryFile() {
+        return libraryFile;
+    }
+
+    /**
+     * Returns true if running in a GraalVM native image, rather than on a JVM.
+     */
+    static boolean isNativeImage() {
+        return "runtime".equals(System.getProperty("org.graalvm.nativeimage.imagecode"));
+    }
+
+    /**
+     * Loads the library linked statically into the native image, or else installed next
+     * to it, so that it does not need to be extracted.
+     *
+     * @return True if the library was loaded
+     */
+    private static boolean loadNativeImageLibrary() {
+        for (String name : new String[] {STATIC_LIBRARY_NAME, "h3-java"}) {
+            try {
+                System.loadLibrary(name);
+                return true;
+            } catch (UnsatisfiedLinkError e) {
+                // Try the next way, and finally extracting the library
+            }
+        }
+        return false;
+    }
+
     /**
      * For use when the H3 library is installed system-wide and Java is able to locate it.
      *
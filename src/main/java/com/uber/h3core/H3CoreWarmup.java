@@ -0,0 +1,223 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.exceptions.DistanceUndefinedException;
+import com.uber.h3core.exceptions.LineUndefinedException;
+import com.uber.h3core.exceptions.LocalIjUndefinedException;
+import com.uber.h3core.exceptions.PentagonEncounteredException;
+import com.uber.h3core.util.CoordIJ;
+import com.uber.h3core.util.GeoCoord;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+
+/**
+ * Calls every native binding, and the Java code around them, on a background thread so
+ * that symbols are bound and hot paths are compiled before they are needed.
+ *
+ * <p>Compilation is shared by the process, so there is one warmup for all instances of
+ * {@link H3Core}.
+ */
+final class H3CoreWarmup implements Runnable {
+    /**
+     * Number of rounds of the cheap, per index calls. This is past the JIT compilation
+     * thresholds of the JVM. The more expensive calls are made every
+     * {@link #REGION_INTERVAL} rounds.
+     */
+    static final int ROUNDS = 20_000;
+    private static final int REGION_INTERVAL = 100;
+
+    private static final int RES = 9;
+    private static final double[] ORIGINS = {
+            37.775938728915946, -122.41795063018799,
+            51.5072, -0.1276,
+            -33.8688, 151.2093,
+            40.7128, -74.0060
+    };
+
+    private static CompletableFuture<Void> future;
+
+    private final H3Core h3;
+    private final CompletableFuture<Void> result;
+
+    private H3CoreWarmup(H3Core h3, CompletableFuture<Void> result) {
+        this.h3 = h3;
+        this.result = result;
+    }
+
+    /**
+     * Starts the warmup on a daemon thread, if it was not already started.
+     *
+     * @return Completed when the warmup finishes
+     */
+    static synchronized CompletableFuture<Void> start(H3Core h3) {
+        if (future == null) {
+            future = new CompletableFuture<>();
+            Thread thread = new Thread(new H3CoreWarmup(h3, future), "h3-warmup");
+            thread.setDaemon(true);
+            thread.setPriority(Thread.MIN_PRIORITY);
+            thread.start();
+        }
+        return future;
+    }
+
+    /**
+     * Returns true if the warmup finished without an error.
+     */
+    static synchronized boolean isDone() {
+        return future != null && future.isDone() && !future.isCompletedExceptionally();
+    }
+
+    @Override
+    public void run() {
+        try {
+            for (int i = 0; i < ROUNDS; i++) {
+                int origin = 2 * (i % (ORIGINS.length / 2));
+                long cell = indexRound(ORIGINS[origin], ORIGINS[origin + 1]);
+                if (i % REGION_INTERVAL == 0) {
+                    regionRound(cell);
+                }
+            }
+            result.complete(null);
+        } catch (Throwable t) {
+            result.completeExceptionally(t);
+        }
+    }
+
+    /**
+     * Calls the bindings which operate on a few indexes.
+     *
+     * @return Index of the point at {@link #RES}
+     */
+    private long indexRound(double lat, double lng) throws PentagonEncounteredException,
+            DistanceUndefinedException, LocalIjUndefinedException, LineUndefinedException {
+        long cell = h3.geoToH3(lat, lng, RES);
+        String address = h3.h3ToString(cell);
+        h3.stringToH3(address);
+        h3.h3IsValid(cell);
+        h3.h3GetBaseCell(cell);
+        h3.h3IsPentagon(cell);
+        h3.h3IsResClassIII(cell);
+        h3.h3GetFaces(cell);
+        h3.h3ToGeo(cell);
+        h3.h3ToGeoBoundary(cell);
+
+        long parent = h3.h3ToParent(cell, RES - 2);
+        h3.h3ToChildren(parent, RES);
+        h3.h3ToCenterChild(parent, RES);
+
+        List<Long> ring = h3.hexRing(cell, 2);
+        h3.kRing(cell, 1);
+        h3.kRingDistances(cell, 1);
+        h3.hexRange(cell, 1);
+        long neighbor = ring.get(0);
+        h3.h3Distance(cell, neighbor);
+        h3.h3Line(cell, neighbor);
+        CoordIJ ij = h3.experimentalH3ToLocalIj(cell, neighbor);
+        h3.experimentalLocalIjToH3(cell, ij);
+
+        long adjacent = h3.hexRing(cell, 1).get(0);
+        h3.h3IndexesAreNeighbors(cell, adjacent);
+        long edge = h3.getH3UnidirectionalEdge(cell, adjacent);
+        h3.h3UnidirectionalEdgeIsValid(edge);
+        h3.getOriginH3IndexFromUnidirectionalEdge(edge);
+        h3.getDestinationH3IndexFromUnidirectionalEdge(edge);
+        h3.getH3IndexesFromUnidirectionalEdge(edge);
+        h3.getH3UnidirectionalEdgesFromHexagon(cell);
+        h3.getH3UnidirectionalEdgeBoundary(edge);
+
+        for (AreaUnit unit : AreaUnit.values()) {
+            h3.cellArea(cell, unit);
+        }
+        for (LengthUnit unit : LengthUnit.values()) {
+            h3.exactEdgeLength(edge, unit);
+            h3.pointDist(new GeoCoord(lat, lng), new GeoCoord(lat + 0.01, lng), unit);
+        }
+        return cell;
+    }
+
+    /**
+     * Calls the bindings which operate on regions and batches.
+     */
+    private void regionRound(long cell) {
+        GeoCoord center = h3.h3ToGeo(cell);
+        List<Long> disk = h3.kRing(cell, 4);
+        long[] cells = disk.stream().mapToLong(Long::longValue).toArray();
+
+        List<GeoCoord> boundary = h3.h3ToGeoBoundary(h3.h3ToParent(cell, RES - 2));
+        h3.polyfill(boundary, Collections.emptyList(), RES);
+        try (PreparedGeoPolygon prepared = h3.preparePolygon(boundary, Collections.emptyList())) {
+            prepared.contains(center.lat, center.lng);
+            prepared.polyfill(RES);
+        }
+        double[] verts = new double[boundary.size() * 2];
+        for (int i = 0; i < boundary.size(); i++) {
+            verts[2 * i] = boundary.get(i).lat;
+            verts[2 * i + 1] = boundary.get(i).lng;
+        }
+        h3.polyfillBatch(verts, new int[]{0, boundary.size()}, new int[]{0, 1}, RES, 1);
+        h3.polyfillBBox(center.lat - 0.01, center.lng - 0.01, center.lat + 0.01, center.lng + 0.01, RES);
+        h3.polyfillCircle(center.lat, center.lng, 500, RES);
+
+        double[] line = {center.lat, center.lng, center.lat + 0.01, center.lng + 0.01};
+        h3.geoToH3(line, RES);
+        h3.geoToH3Approx(line, RES);
+        h3.polylineToCells(line, RES);
+        h3.polylineToCellsBatch(line, new int[]{0, 2}, RES, 0, 0, 1);
+
+        List<Long> compacted = h3.compact(disk);
+        h3.uncompact(compacted, RES);
+        h3.h3SetToMultiPolygon(disk, false);
+        h3.h3SetToMultiPolygon(compacted, false);
+        h3.h3SetToMultiPolygon(disk, false, 10);
+        DynamicOutline outline = h3.newDynamicOutline();
+        for (long c : cells) {
+            outline.add(c);
+        }
+        outline.toFlat();
+
+        h3.h3ToGeo(cells, 1);
+        h3.h3ToGeoBoundary(cells, new int[cells.length + 1], 1);
+        h3.cellArea(cells, AreaUnit.m2, 1);
+        h3.h3ToParent(cells, RES - 2, 1);
+        h3.h3Distance(cells, cells, 1);
+        h3.boundaryEdges(cells);
+        h3.cellsToMesh(cells);
+        h3.cellBBox(cells, new double[cells.length * 4]);
+        h3.cellParentBBox(cells, RES - 2, new double[cells.length * 4]);
+        h3.cellCentersToPlanar(cells, center.lat, center.lng, PlanarProjection.enu);
+        h3.cellBoundariesToPlanarFloat(cells, center.lat, center.lng, PlanarProjection.azimuthalEquidistant,
+                new int[cells.length + 1]);
+
+        h3.openCells(cells, 1);
+        h3.closeCells(cells, 1);
+        h3.connectedComponents(cells);
+        h3.fillHoles(cells, 7);
+        double[] values = new double[cells.length];
+        Arrays.fill(values, 1);
+        h3.buildPyramid(cells, values, RES - 2, Aggregation.sum);
+
+        h3.hexArea(RES, AreaUnit.m2);
+        h3.edgeLength(RES, LengthUnit.m);
+        h3.numHexagons(RES);
+        h3.getRes0Indexes();
+        new ArrayList<>(h3.getPentagonIndexes(RES));
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+/**
+ * Sorting of positions in parallel arrays, without boxing them.
+ */
+final class IndexSort {
+    /**
+     * Compares the elements at two positions.
+     */
+    interface PositionComparator {
+        int compare(int a, int b);
+    }
+
+    /**
+     * Runs shorter than this are sorted by insertion.
+     */
+    private static final int INSERTION_SORT_MAX = 16;
+
+    private IndexSort() {
+        // Static methods only
+    }
+
+    /**
+     * Returns the positions of the keys in ascending order of the keys. Equal keys keep
+     * their order.
+     */
+    static int[] sortedOrder(long[] keys) {
+        return sortedOrder(keys.length, (a, b) -> Long.compare(keys[a], keys[b]));
+    }
+
+    /**
+     * Returns the positions <code>0</code> to <code>size - 1</code> sorted by the
+     * comparator. Positions which compare equal keep their order.
+     */
+    static int[] sortedOrder(int size, PositionComparator comparator) {
+        int[] order = new int[size];
+        for (int i = 0; i < size; i++) {
+            order[i] = i;
+        }
+        if (size > 1) {
+            mergeSort(order, order.clone(), 0, size, comparator);
+        }
+        return order;
+    }
+
+    /**
+     * Sorts <code>order[from, to)</code>, using <code>buffer</code>, which has the same
+     * contents in that range, as scratch space.
+     */
+    private static void mergeSort(int[] order, int[] buffer, int from, int to, PositionComparator comparator) {
+        if (to - from <= INSERTION_SORT_MAX) {
+            for (int i = from + 1; i < to; i++) {
+                int position = order[i];
+                int j = i;
+                for (; j > from && comparator.compare(order[j - 1], position) > 0; j--) {
+                    order[j] = order[j - 1];
+                }
+                order[j] = position;
+            }
+            return;
+        }
+
+        // Sort each half of buffer, using order as scratch, then merge them into order
+        int mid = (from + to) >>> 1;
+        mergeSort(buffer, order, from, mid, comparator);
+        mergeSort(buffer, order, mid, to, comparator);
+        if (comparator.compare(buffer[mid - 1], buffer[mid]) <= 0) {
+            System.arraycopy(buffer, from, order, from, to - from);
+            return;
+        }
+        for (int i = from, left = from, right = mid; i < to; i++) {
+            if (right >= to || (left < mid && comparator.compare(buffer[left], buffer[right]) <= 0)) {
+                order[i] = buffer[left++];
+            } else {
+                order[i] = buffer[right++];
+            }
+        }
+    }
+}
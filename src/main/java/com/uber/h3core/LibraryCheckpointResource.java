@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import org.crac.Context;
+import org.crac.Core;
+import org.crac.Resource;
+
+/**
+ * Notifies {@link H3CoreLoader} of CRaC (Coordinated Restore at Checkpoint) checkpoints, so
+ * the extracted native library is not left behind in them.
+ *
+ * <p>This is the only class which refers to <code>org.crac</code>, which is an optional
+ * dependency. It is only loaded once that is found to be on the class path.
+ */
+final class LibraryCheckpointResource implements Resource {
+    /**
+     * CRaC contexts only hold weak references to their resources, so this one is kept here.
+     */
+    private static LibraryCheckpointResource instance;
+
+    private LibraryCheckpointResource() {
+        // Use register
+    }
+
+    /**
+     * Registers with the global context, once.
+     */
+    static synchronized void register() {
+        if (instance == null) {
+            instance = new LibraryCheckpointResource();
+            Core.getGlobalContext().register(instance);
+        }
+    }
+
+    @Override
+    public void beforeCheckpoint(Context<? extends Resource> context) {
+        H3CoreLoader.beforeCheckpoint();
+    }
+
+    @Override
+    public void afterRestore(Context<? extends Resource> context) {
+        // The library is still mapped into the restored process, so it is only checked
+        // rather than extracted again
+        H3CoreLoader.afterRestore();
+    }
+
+    /**
+     * Returns true if the resource has been registered.
+     */
+    static synchronized boolean isRegistered() {
+        return instance != null;
+    }
+}
@@ -37,6 +37,13 @@ final class NativeMethods {
     native int h3GetBaseCell(long h3);
     native boolean h3IsPentagon(long h3);
     native long geoToH3(double lat, double lon, int res);
+    native void geoToH3Batch(double[] coords, int res, int numThreads, long[] results);
+    native void geoToH3BatchApprox(double[] coords, int res, long[] results);
+    native void h3ToGeoBatch(long[] h3, int numThreads, double[] results);
+    native void h3ToGeoBoundaryBatch(long[] h3, int numThreads, int[] offsets, double[] results);
+    native void cellAreaBatch(long[] h3, int unit, int numThreads, double[] results);
+    native void h3ToParentBatch(long[] h3, int res, int numThreads, long[] results);
+    native void h3DistanceBatch(long[] origins, long[] destinations, int numThreads, int[] results);
     native void h3ToGeo(long h3, double[] verts);
     native int h3ToGeoBoundary(long h3, double[] verts);
 
@@ -55,7 +62,31 @@ final class NativeMethods {
     native int maxPolyfillSize(double[] verts, int[] holeSizes, double[] holeVerts, int res);
     native void polyfill(double[] verts, int[] holeSizes, double[] holeVerts, int res, long[] results);
 
+    native long createPreparedPolygon(double[] verts, int[] holeSizes, double[] holeVerts);
+    native void destroyPreparedPolygon(long polygon);
+    native boolean preparedPolygonContains(long polygon, double lat, double lng);
+    native long[] polyfillPrepared(long polygon, int res);
+    native long[] polyfillBBox(double south, double west, double north, double east, int res);
+    native long[] polyfillCircle(double lat, double lng, double radiusMeters, int res);
+    native long[] polyfillBatch(double[] verts, int[] ringOffsets, int[] polygonOffsets, int res, int numThreads,
+                                int[] resultOffsets);
+    native long[] polylineToCellsBatch(double[] verts, int[] lineOffsets, int res, double densifyMeters, int k,
+                                       int numThreads, int[] resultOffsets);
+
     native void h3SetToLinkedGeo(long[] h3, ArrayList<List<List<GeoCoord>>> results);
+    native void compactedSetToLinkedGeo(long[] h3, ArrayList<List<List<GeoCoord>>> results);
+    native void h3SetToSimplifiedLinkedGeo(long[] h3, double toleranceMeters,
+                                           ArrayList<List<List<GeoCoord>>> results);
+    native long[] regionBoundary(long[] h3, int[] resultOffsets);
+    native double[] cellsToMesh(long[] h3, int[] offsets, int[] indices);
+    native void cellBBox(long[] h3, double[] results);
+    native void cellCentersToPlanar(long[] h3, double originLat, double originLng, int projection,
+                                    double[] doubleResults, float[] floatResults);
+    native void cellBoundariesToPlanar(long[] h3, double originLat, double originLng, int projection, int[] offsets,
+                                       double[] doubleResults, float[] floatResults);
+    native long[] cellMorphology(long[] h3, int operation, int k, int numThreads);
+    native int[] cellComponents(long[] h3, int minSize, long[] results);
+    native long[] fillHoles(long[] h3, int maxHoleSize);
 
     native int compact(long[] h3, long[] results);
     native int maxUncompactSize(long[] h3, int res);
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.uber.h3core;
+
+/**
+ * Projection onto a plane tangent to the sphere at an origin, with x east and y north
+ * of the origin, in meters.
+ */
+public enum PlanarProjection {
+    // The order of these matches PlanarProjection in planar.h
+    /**
+     * East and north of the local east-north-up frame, projecting each point orthogonally
+     * onto the tangent plane. Distances are accurate near the origin, and shrink with
+     * distance from it.
+     */
+    enu,
+    /**
+     * Azimuthal equidistant, in which distances and directions from the origin are exact.
+     */
+    azimuthalEquidistant
+}
@@ -0,0 +1,413 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.util.GeoCoord;
+import com.uber.h3core.util.GroupedCells;
+import com.uber.h3core.util.TaskTiming;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.RecursiveAction;
+
+import static java.lang.Math.toRadians;
+
+/**
+ * Fills many polygons of differing sizes on a work-stealing {@link ForkJoinPool}.
+ *
+ * <p>Small polygons are each filled by one task. Large polygons are split into tiles of
+ * coarser parent cells, so that one large polygon is spread across the pool rather than
+ * leaving the rest of the pool idle while it is filled. Parents well inside the polygon
+ * contribute all their children without testing them, and only the children of parents
+ * near its edges are tested.
+ *
+ * <p>Create with {@link H3Core#newPolyfillExecutor(ForkJoinPool)}. Instances may be used
+ * from multiple threads.
+ */
+public final class PolyfillExecutor {
+    /**
+     * Estimated number of cells above which a polygon is split into tiles.
+     */
+    private static final long SPLIT_MIN_CELLS = 1 << 16;
+    /**
+     * Number of resolutions the tiles are coarser than the cells, so each has 343 children.
+     */
+    private static final int TILE_RES_OFFSET = 3;
+    /**
+     * Approximate number of cells each task of a split polygon checks.
+     */
+    private static final int TASK_CELLS = 1 << 15;
+
+    private final H3Core h3;
+    private final ForkJoinPool pool;
+
+    PolyfillExecutor(H3Core h3, ForkJoinPool pool) {
+        this.h3 = h3;
+        this.pool = pool;
+    }
+
+    /**
+     * Finds indexes within each of the given polygons.
+     *
+     * @see #polyfill(double[], int[], int[], int, boolean, List)
+     */
+    public GroupedCells polyfill(double[] verts, int[] ringOffsets, int[] polygonOffsets, int res) {
+        return polyfill(verts, ringOffsets, polygonOffsets, res, false, null);
+    }
+
+    /**
+     * Finds indexes within each of the given polygons, as
+     * {@link H3Core#polyfillBatch(double[], int[], int[], int)} does, using the pool.
+     *
+     * <p>The cells of each polygon are sorted, so the result is the same however the work
+     * was scheduled.
+     *
+     * @param verts Interleaved latitudes and longitudes of all vertices, in degrees
+     * @param ringOffsets Index of the first vertex of each ring, followed by the number of vertices
+     * @param polygonOffsets Index of the first ring of each polygon, followed by the number of rings
+     * @param res Resolution of the desired indexes
+     * @param compact Whether to compact the cells of each polygon, as {@link H3Core#compact(java.util.Collection)}
+     *                does. The interiors of split polygons are then not uncompacted at all.
+     * @param timings If not null, a timing is added for each task, ordered by polygon then task
+     * @return Cells for each polygon, in the order the polygons were given
+     * @throws IllegalArgumentException Invalid resolution, or offsets out of range
+     */
+    public GroupedCells polyfill(double[] verts, int[] ringOffsets, int[] polygonOffsets, int res,
+                                 boolean compact, List<TaskTiming> timings) {
+        H3Core.checkResolution(res);
+        H3Core.checkOffsets(ringOffsets, H3Core.checkLatLngs(verts), "ringOffsets");
+        H3Core.checkOffsets(polygonOffsets, ringOffsets.length - 1, "polygonOffsets");
+
+        int numPolygons = polygonOffsets.length - 1;
+        PolygonTask[] tasks = new PolygonTask[numPolygons];
+        for (int p = 0; p < numPolygons; p++) {
+            tasks[p] = new PolygonTask(p, verts, ringOffsets, polygonOffsets[p], polygonOffsets[p + 1], res,
+                    compact);
+        }
+        pool.invoke(new RecursiveAction() {
+            @Override
+            protected void compute() {
+                invokeAll(tasks);
+            }
+        });
+
+        int[] offsets = new int[numPolygons + 1];
+        long[][] polygonCells = new long[numPolygons][];
+        for (int p = 0; p < numPolygons; p++) {
+            polygonCells[p] = tasks[p].merge();
+            offsets[p + 1] = offsets[p] + polygonCells[p].length;
+            if (timings != null) {
+                tasks[p].addTimings(timings);
+            }
+        }
+        long[] cells = new long[offsets[numPolygons]];
+        for (int p = 0; p < numPolygons; p++) {
+            System.arraycopy(polygonCells[p], 0, cells, offsets[p], polygonCells[p].length);
+        }
+        return new GroupedCells(cells, offsets);
+    }
+
+    /**
+     * Fills one polygon, either in one task or by forking a task for each group of tiles.
+     */
+    private final class PolygonTask extends RecursiveAction {
+        private final int polygon;
+        private final double[] verts;
+        private final int[] ringOffsets;
+        private final int firstRing;
+        private final int endRing;
+        private final int res;
+        private final boolean compact;
+        /**
+         * Results of the leaf tasks, in order.
+         */
+        private final List<TileTask> tiles = new ArrayList<>();
+        private long[] wholeCells;
+        private long wholeNanos;
+
+        PolygonTask(int polygon, double[] verts, int[] ringOffsets, int firstRing, int endRing, int res,
+                    boolean compact) {
+            this.polygon = polygon;
+            this.verts = verts;
+            this.ringOffsets = ringOffsets;
+            this.firstRing = firstRing;
+            this.endRing = endRing;
+            this.res = res;
+            this.compact = compact;
+        }
+
+        @Override
+        protected void compute() {
+            if (firstRing == endRing) {
+                wholeCells = new long[0];
+            } else if (res < TILE_RES_OFFSET || crossesAntimeridian() || estimateCells() < SPLIT_MIN_CELLS) {
+                fillWhole();
+            } else {
+                fillTiles();
+            }
+        }
+
+        private void fillWhole() {
+            long start = System.nanoTime();
+            int vertOffset = ringOffsets[firstRing];
+            int[] localRingOffsets = new int[endRing - firstRing + 1];
+            for (int r = 0; r < localRingOffsets.length; r++) {
+                localRingOffsets[r] = ringOffsets[firstRing + r] - vertOffset;
+            }
+            double[] localVerts = Arrays.copyOfRange(verts, vertOffset * 2, ringOffsets[endRing] * 2);
+            long[] cells = h3.polyfillBatch(localVerts, localRingOffsets, new int[]{0, localRingOffsets.length - 1},
+                    res, 1).cells;
+            wholeCells = compact ? h3.compact(cells) : cells;
+            wholeNanos = System.nanoTime() - start;
+        }
+
+        private void fillTiles() {
+            int tileRes = res - TILE_RES_OFFSET;
+            List<GeoCoord> outline = ring(firstRing);
+            List<List<GeoCoord>> holes = new ArrayList<>();
+            for (int r = firstRing + 1; r < endRing; r++) {
+                holes.add(ring(r));
+            }
+
+            // Children of a tile spill a little outside its hexagon, so tiles next to one
+            // the edge passes through may also have children on both sides of it. Edges are
+            // straight in latitude and longitude, as for polyfill, and are followed as short
+            // arcs, so tiles within a step of those arcs are expanded by another step.
+            double densifyMeters = h3.edgeLength(tileRes, LengthUnit.m);
+            Set<Long> pathTiles = new HashSet<>();
+            for (int r = firstRing; r < endRing; r++) {
+                double[] ring = closedRing(r);
+                if (ring.length == 0) {
+                    continue;
+                }
+                for (long tile : h3.polylineToCells(ring, tileRes, densifyMeters, 1)) {
+                    pathTiles.add(tile);
+                }
+            }
+            Set<Long> edgeTiles = new HashSet<>();
+            for (long tile : pathTiles) {
+                edgeTiles.addAll(h3.kRing(tile, 1));
+            }
+            // Every other tile is entirely inside or outside, and is inside if its center is
+            List<Long> interiorTiles = new ArrayList<>();
+            for (long tile : h3.polyfill(outline, holes, tileRes)) {
+                if (!edgeTiles.contains(tile)) {
+                    interiorTiles.add(tile);
+                }
+            }
+
+            try (PreparedGeoPolygon prepared = h3.preparePolygon(outline, holes)) {
+                int tilesPerTask = Math.max(1, TASK_CELLS / (int) Math.pow(7, TILE_RES_OFFSET));
+                addTileTasks(sorted(interiorTiles), tilesPerTask, null);
+                addTileTasks(sorted(edgeTiles), tilesPerTask, prepared);
+                invokeAll(tiles);
+            }
+        }
+
+        private void addTileTasks(long[] tileCells, int tilesPerTask, PreparedGeoPolygon prepared) {
+            for (int i = 0; i < tileCells.length; i += tilesPerTask) {
+                tiles.add(new TileTask(Arrays.copyOfRange(tileCells, i, Math.min(tileCells.length, i + tilesPerTask)),
+                        res, compact, prepared));
+            }
+        }
+
+        /**
+         * Estimates the number of cells in the polygon from the area of its bounding box.
+         */
+        private double estimateCells() {
+            double south = Double.POSITIVE_INFINITY;
+            double north = Double.NEGATIVE_INFINITY;
+            double west = Double.POSITIVE_INFINITY;
+            double east = Double.NEGATIVE_INFINITY;
+            for (int v = ringOffsets[firstRing]; v < ringOffsets[firstRing + 1]; v++) {
+                south = Math.min(south, verts[v * 2]);
+                north = Math.max(north, verts[v * 2]);
+                west = Math.min(west, verts[v * 2 + 1]);
+                east = Math.max(east, verts[v * 2 + 1]);
+            }
+            if (south > north) {
+                return 0;
+            }
+            double areaRads2 = toRadians(east - west) * (Math.sin(toRadians(north)) - Math.sin(toRadians(south)));
+            return areaRads2 / (4 * Math.PI) * h3.numHexagons(res);
+        }
+
+        /**
+         * Returns true if any edge spans more than 180 degrees of longitude. Those are not
+         * split, as the edges of tiles would go the other way around.
+         */
+        private boolean crossesAntimeridian() {
+            for (int r = firstRing; r < endRing; r++) {
+                double[] ring = closedRing(r);
+                for (int i = 2; i < ring.length; i += 2) {
+                    if (Math.abs(ring[i + 1] - ring[i - 1]) > 180) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        private List<GeoCoord> ring(int r) {
+            List<GeoCoord> ring = new ArrayList<>();
+            for (int v = ringOffsets[r]; v < ringOffsets[r + 1]; v++) {
+                ring.add(new GeoCoord(verts[v * 2], verts[v * 2 + 1]));
+            }
+            return ring;
+        }
+
+        /**
+         * Interleaved vertices of the ring, with the first repeated at the end.
+         */
+        private double[] closedRing(int r) {
+            int start = ringOffsets[r] * 2;
+            int end = ringOffsets[r + 1] * 2;
+            if (start == end) {
+                return new double[0];
+            }
+            double[] ring = Arrays.copyOfRange(verts, start, end + 2);
+            ring[end - start] = verts[start];
+            ring[end - start + 1] = verts[start + 1];
+            return ring;
+        }
+
+        /**
+         * Combines the results of the tasks and sorts them.
+         */
+        long[] merge() {
+            long[] cells;
+            if (wholeCells != null) {
+                cells = wholeCells;
+            } else if (compact) {
+                // Whole tiles may compact further with each other. Cells finer than the tiles
+                // are in partial tiles, so they cannot.
+                int tileRes = res - TILE_RES_OFFSET;
+                int numWholeTiles = 0;
+                int numCells = 0;
+                for (TileTask tile : tiles) {
+                    for (long cell : tile.cells) {
+                        if (h3.h3GetResolution(cell) == tileRes) {
+                            numWholeTiles++;
+                        }
+                    }
+                    numCells += tile.cells.length;
+                }
+                long[] wholeTiles = new long[numWholeTiles];
+                long[] partial = new long[numCells - numWholeTiles];
+                int wholeOffset = 0;
+                int partialOffset = 0;
+                for (TileTask tile : tiles) {
+                    for (long cell : tile.cells) {
+                        if (h3.h3GetResolution(cell) == tileRes) {
+                            wholeTiles[wholeOffset++] = cell;
+                        } else {
+                            partial[partialOffset++] = cell;
+                        }
+                    }
+                }
+                long[] compacted = h3.compact(wholeTiles);
+                cells = Arrays.copyOf(partial, partial.length + compacted.length);
+                System.arraycopy(compacted, 0, cells, partial.length, compacted.length);
+            } else {
+                int numCells = 0;
+                for (TileTask tile : tiles) {
+                    numCells += tile.cells.length;
+                }
+                cells = new long[numCells];
+                int offset = 0;
+                for (TileTask tile : tiles) {
+                    System.arraycopy(tile.cells, 0, cells, offset, tile.cells.length);
+                    offset += tile.cells.length;
+                }
+            }
+            Arrays.sort(cells);
+            return cells;
+        }
+
+        void addTimings(List<TaskTiming> timings) {
+            if (wholeCells != null) {
+                timings.add(new TaskTiming(polygon, 0, wholeCells.length, wholeNanos));
+            }
+            for (int t = 0; t < tiles.size(); t++) {
+                timings.add(new TaskTiming(polygon, t, tiles.get(t).cells.length, tiles.get(t).nanos));
+            }
+        }
+    }
+
+    /**
+     * Finds the cells within the polygon in a group of tiles. Without a prepared polygon,
+     * the tiles are all inside it.
+     */
+    private final class TileTask extends RecursiveAction {
+        private final long[] tileCells;
+        private final int res;
+        private final boolean compact;
+        private final PreparedGeoPolygon prepared;
+        long[] cells;
+        long nanos;
+
+        TileTask(long[] tileCells, int res, boolean compact, PreparedGeoPolygon prepared) {
+            this.tileCells = tileCells;
+            this.res = res;
+            this.compact = compact;
+            this.prepared = prepared;
+        }
+
+        @Override
+        protected void compute() {
+            long start = System.nanoTime();
+            if (prepared == null) {
+                cells = compact ? tileCells : h3.h3ToChildren(tileCells, res);
+            } else {
+                // Each tile has at most as many cells inside as a hexagon tile has children
+                long[] found = new long[tileCells.length * (int) Math.pow(7, TILE_RES_OFFSET)];
+                int numFound = 0;
+                for (long tile : tileCells) {
+                    long[] children = h3.h3ToChildren(new long[]{tile}, res);
+                    double[] centers = h3.h3ToGeo(children, 1);
+                    int numInside = 0;
+                    for (int i = 0; i < children.length; i++) {
+                        if (prepared.contains(centers[i * 2], centers[i * 2 + 1])) {
+                            found[numFound + numInside++] = children[i];
+                        }
+                    }
+                    if (compact && numInside == children.length) {
+                        found[numFound++] = tile;
+                    } else if (compact && numInside > 0) {
+                        long[] compacted = h3.compact(Arrays.copyOfRange(found, numFound, numFound + numInside));
+                        System.arraycopy(compacted, 0, found, numFound, compacted.length);
+                        numFound += compacted.length;
+                    } else {
+                        numFound += numInside;
+                    }
+                }
+                cells = Arrays.copyOf(found, numFound);
+            }
+            nanos = System.nanoTime() - start;
+        }
+    }
+
+    private static long[] sorted(Collection<Long> cells) {
+        long[] array = cells.stream().mapToLong(Long::longValue).toArray();
+        Arrays.sort(array);
+        return array;
+    }
+}
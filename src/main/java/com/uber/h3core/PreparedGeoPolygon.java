@@ -0,0 +1,96 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import static java.lang.Math.toRadians;
+
+/**
+ * A polygon whose edges have been indexed in native memory, so that repeated
+ * containment tests and polyfills only visit the edges near each point.
+ *
+ * <p>Create with {@link H3Core#preparePolygon(List, List)}. The native memory is
+ * held until {@link #close()} is called. Instances may be used from multiple threads,
+ * but must not be closed while in use: calling {@link #close()} concurrently with
+ * {@link #contains(double, double)} or {@link #polyfill(int)} frees the native memory
+ * those calls are reading, which can crash the JVM.
+ */
+public final class PreparedGeoPolygon implements AutoCloseable {
+    private final NativeMethods h3Api;
+    /**
+     * Native pointer to the prepared polygon, or 0 once closed. Volatile rather than
+     * guarded, so concurrent containment tests do not contend for a lock.
+     */
+    private volatile long polygon;
+
+    PreparedGeoPolygon(NativeMethods h3Api, long polygon) {
+        this.h3Api = h3Api;
+        this.polygon = polygon;
+    }
+
+    /**
+     * Returns true if the point is inside the polygon, using the same rule as
+     * {@link H3Core#polyfill(List, List, int)} uses for cell centers.
+     *
+     * @param lat Latitude in degrees.
+     * @param lng Longitude in degrees.
+     * @throws IllegalStateException The polygon has been closed.
+     */
+    public boolean contains(double lat, double lng) {
+        return h3Api.preparedPolygonContains(checkOpen(), toRadians(lat), toRadians(lng));
+    }
+
+    /**
+     * Finds indexes within the polygon.
+     *
+     * @param res Resolution of the desired indexes
+     * @throws IllegalArgumentException Invalid resolution
+     * @throws IllegalStateException The polygon has been closed.
+     */
+    public List<Long> polyfill(int res) {
+        H3Core.checkResolution(res);
+
+        long[] cells = h3Api.polyfillPrepared(checkOpen(), res);
+
+        List<Long> result = new ArrayList<>(cells.length);
+        for (long cell : cells) {
+            result.add(cell);
+        }
+        return result;
+    }
+
+    /**
+     * Frees the native memory held by this polygon. Calling this more than once
+     * has no effect.
+     */
+    @Override
+    public synchronized void close() {
+        if (polygon != 0) {
+            h3Api.destroyPreparedPolygon(polygon);
+            polygon = 0;
+        }
+    }
+
+    private long checkOpen() {
+        long current = polygon;
+        if (current == 0) {
+            throw new IllegalStateException("Prepared polygon has been closed");
+        }
+        return current;
+    }
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import java.util.Arrays;
+
+/**
+ * Counts and sums of values of events in each index over a sliding window of time,
+ * such as events in the last five minutes.
+ *
+ * <p>The window is divided into buckets of equal length, and each index keeps a ring
+ * buffer of buckets in primitive arrays. A bucket is reused once its time is out of the
+ * window, and indexes with no buckets in the window are dropped when the table grows, so
+ * adding an event does not allocate. Events older than the window are ignored.
+ *
+ * <p>Create with {@link H3Core#newSlidingWindowAggregator(int, long, int)}. Instances
+ * are not thread safe.
+ */
+public final class SlidingWindowAggregator {
+    private static final int INITIAL_CAPACITY = 1024;
+
+    private final H3Core h3;
+    private final int res;
+    private final long bucketMillis;
+    private final int numBuckets;
+
+    /**
+     * Indexes, or 0 for empty slots, in an open addressing table.
+     */
+    private long[] keys;
+    /**
+     * Bucket number (time divided by the bucket length) of each bucket of each slot, or
+     * Long.MIN_VALUE if it has not been used.
+     */
+    private long[] bucketTimes;
+    private long[] counts;
+    private double[] sums;
+    private int size;
+    private long latestBucket = Long.MIN_VALUE;
+
+    SlidingWindowAggregator(H3Core h3, int res, long bucketMillis, int numBuckets) {
+        H3Core.checkResolution(res);
+        if (bucketMillis < 1) {
+            throw new IllegalArgumentException("bucketMillis must be at least 1");
+        }
+        if (numBuckets < 1) {
+            throw new IllegalArgumentException("numBuckets must be at least 1");
+        }
+        this.h3 = h3;
+        this.res = res;
+        this.bucketMillis = bucketMillis;
+        this.numBuckets = numBuckets;
+        allocate(INITIAL_CAPACITY);
+    }
+
+    /**
+     * Resolution of the indexes events are counted in.
+     */
+    public int getRes() {
+        return res;
+    }
+
+    /**
+     * Length of the window, in milliseconds.
+     */
+    public long getWindowMillis() {
+        return bucketMillis * numBuckets;
+    }
+
+    /**
+     * Adds an event at the point.
+     *
+     * @param lat Latitude in degrees
+     * @param lng Longitude in degrees
+     * @param timeMillis Time of the event, in milliseconds
+     * @param value Value to add to the sum
+     * @throws IllegalArgumentException Latitude or longitude is invalid
+     */
+    public void add(double lat, double lng, long timeMillis, double value) {
+        add(h3.geoToH3(lat, lng, res), timeMillis, value);
+    }
+
+    /**
+     * Adds an event in the index.
+     *
+     * @param h3 Index of the resolution of this aggregator
+     * @param timeMillis Time of the event, in milliseconds
+     * @param value Value to add to the sum
+     * @throws IllegalArgumentException The index is not of the resolution of this aggregator
+     */
+    public void add(long h3, long timeMillis, double value) {
+        if (this.h3.h3GetResolution(h3) != res || h3 == 0) {
+            throw new IllegalArgumentException(String.format("Index %x is not of resolution %d", h3, res));
+        }
+        long bucket = Math.floorDiv(timeMillis, bucketMillis);
+        if (bucket > latestBucket) {
+            latestBucket = bucket;
+        } else if (bucket <= latestBucket - numBuckets) {
+            return;
+        }
+
+        int slot = find(h3);
+        if (slot < 0) {
+            if ((size + 1) * 2 > keys.length) {
+                grow();
+            }
+            slot = insert(h3);
+        }
+        int entry = slot * numBuckets + (int) Math.floorMod(bucket, (long) numBuckets);
+        if (bucketTimes[entry] != bucket) {
+            if (bucketTimes[entry] > bucket) {
+                // A later event already reused the bucket
+                return;
+            }
+            bucketTimes[entry] = bucket;
+            counts[entry] = 0;
+            sums[entry] = 0;
+        }
+        counts[entry]++;
+        sums[entry] += value;
+    }
+
+    /**
+     * Returns the number of events in the window ending at <code>nowMillis</code>, in the
+     * index or, for a coarser index, in its children.
+     *
+     * @throws IllegalArgumentException The index is finer than the resolution of this aggregator
+     */
+    public long count(long h3, long nowMillis) {
+        long count = 0;
+        for (int slot : slotsOf(h3)) {
+            count += countSlot(slot, Math.floorDiv(nowMillis, bucketMillis));
+        }
+        return count;
+    }
+
+    /**
+     * Returns the sum of values of events in the window ending at <code>nowMillis</code>,
+     * in the index or, for a coarser index, in its children.
+     *
+     * @throws IllegalArgumentException The index is finer than the resolution of this aggregator
+     */
+    public double sum(long h3, long nowMillis) {
+        double sum = 0;
+        for (int slot : slotsOf(h3)) {
+            sum += sumSlot(slot, Math.floorDiv(nowMillis, bucketMillis));
+        }
+        return sum;
+    }
+
+    /**
+     * Returns the number of events in the window ending at <code>nowMillis</code>, in the
+     * indexes within <code>k</code> steps of the index.
+     *
+     * @param h3 Index of the resolution of this aggregator
+     */
+    public long countKRing(long h3, int k, long nowMillis) {
+        long now = Math.floorDiv(nowMillis, bucketMillis);
+        long count = 0;
+        for (long cell : this.h3.kRing(h3, k)) {
+            int slot = find(cell);
+            if (slot >= 0) {
+                count += countSlot(slot, now);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Returns the sum of values of events in the window ending at <code>nowMillis</code>,
+     * in the indexes within <code>k</code> steps of the index.
+     *
+     * @param h3 Index of the resolution of this aggregator
+     */
+    public double sumKRing(long h3, int k, long nowMillis) {
+        long now = Math.floorDiv(nowMillis, bucketMillis);
+        double sum = 0;
+        for (long cell : this.h3.kRing(h3, k)) {
+            int slot = find(cell);
+            if (slot >= 0) {
+                sum += sumSlot(slot, now);
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * Number of indexes held, including those whose events have left the window but have
+     * not been dropped yet.
+     */
+    public int size() {
+        return size;
+    }
+
+    private long countSlot(int slot, long now) {
+        long count = 0;
+        for (int b = slot * numBuckets; b < (slot + 1) * numBuckets; b++) {
+            if (inWindow(bucketTimes[b], now)) {
+                count += counts[b];
+            }
+        }
+        return count;
+    }
+
+    private double sumSlot(int slot, long now) {
+        double sum = 0;
+        for (int b = slot * numBuckets; b < (slot + 1) * numBuckets; b++) {
+            if (inWindow(bucketTimes[b], now)) {
+                sum += sums[b];
+            }
+        }
+        return sum;
+    }
+
+    private boolean inWindow(long bucket, long now) {
+        return bucket <= now && bucket > now - numBuckets;
+    }
+
+    /**
+     * Returns the slots of the index, or of its descendants for a coarser index, which are
+     * in the table.
+     */
+    private int[] slotsOf(long h3) {
+        int cellRes = this.h3.h3GetResolution(h3);
+        if (cellRes > res) {
+            throw new IllegalArgumentException(String.format("Index %x is finer than resolution %d", h3, res));
+        }
+        if (cellRes == res) {
+            int slot = find(h3);
+            return slot < 0 ? new int[0] : new int[] {slot};
+        }
+
+        // Coarse indexes have more descendants than there are slots, so the slots are
+        // scanned for descendants rather than each descendant looked up.
+        long numDescendants = 1;
+        for (int r = cellRes; r < res && numDescendants <= keys.length; r++) {
+            numDescendants *= 7;
+        }
+        int[] slots = new int[(int) Math.min(numDescendants, keys.length)];
+        int numSlots = 0;
+        if (numDescendants > keys.length) {
+            for (int slot = 0; slot < keys.length; slot++) {
+                if (keys[slot] != 0 && this.h3.h3ToParent(keys[slot], cellRes) == h3) {
+                    slots[numSlots++] = slot;
+                }
+            }
+        } else {
+            for (long child : this.h3.h3ToChildren(new long[] {h3}, res)) {
+                int slot = find(child);
+                if (slot >= 0) {
+                    slots[numSlots++] = slot;
+                }
+            }
+        }
+        return Arrays.copyOf(slots, numSlots);
+    }
+
+    private int find(long h3) {
+        int mask = keys.length - 1;
+        for (int slot = (int) CellHash.mix(h3) & mask; ; slot = (slot + 1) & mask) {
+            if (keys[slot] == h3) {
+                return slot;
+            }
+            if (keys[slot] == 0) {
+                return -1;
+            }
+        }
+    }
+
+    private int insert(long h3) {
+        int mask = keys.length - 1;
+        int slot = (int) CellHash.mix(h3) & mask;
+        while (keys[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        keys[slot] = h3;
+        size++;
+        return slot;
+    }
+
+    /**
+     * Rebuilds the table, dropping indexes with no buckets in the window, and doubling
+     * the capacity if it is still more than a quarter full.
+     */
+    private void grow() {
+        long[] oldKeys = keys;
+        long[] oldBucketTimes = bucketTimes;
+        long[] oldCounts = counts;
+        double[] oldSums = sums;
+
+        int live = 0;
+        for (int slot = 0; slot < oldKeys.length; slot++) {
+            if (oldKeys[slot] != 0 && isLive(oldBucketTimes, slot)) {
+                live++;
+            }
+        }
+        allocate(live * 4 > oldKeys.length ? oldKeys.length * 2 : oldKeys.length);
+
+        for (int slot = 0; slot < oldKeys.length; slot++) {
+            if (oldKeys[slot] != 0 && isLive(oldBucketTimes, slot)) {
+                int newSlot = insert(oldKeys[slot]);
+                System.arraycopy(oldBucketTimes, slot * numBuckets, bucketTimes, newSlot * numBuckets, numBuckets);
+                System.arraycopy(oldCounts, slot * numBuckets, counts, newSlot * numBuckets, numBuckets);
+                System.arraycopy(oldSums, slot * numBuckets, sums, newSlot * numBuckets, numBuckets);
+            }
+        }
+    }
+
+    private boolean isLive(long[] times, int slot) {
+        for (int b = slot * numBuckets; b < (slot + 1) * numBuckets; b++) {
+            if (times[b] > latestBucket - numBuckets) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private void allocate(int capacity) {
+        keys = new long[capacity];
+        bucketTimes = new long[capacity * numBuckets];
+        Arrays.fill(bucketTimes, Long.MIN_VALUE);
+        counts = new long[capacity * numBuckets];
+        sums = new double[capacity * numBuckets];
+        size = 0;
+    }
+}
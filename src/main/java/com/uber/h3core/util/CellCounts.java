@@ -0,0 +1,77 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Counts of a set of indexes, in columnar form, with the cells sorted. The arrays are
+ * not copied, so they should not be modified.
+ */
+public class CellCounts {
+    public final long[] cells;
+    public final long[] counts;
+
+    public CellCounts(long[] cells, long[] counts) {
+        this.cells = cells;
+        this.counts = counts;
+    }
+
+    /**
+     * Number of cells.
+     */
+    public int size() {
+        return cells.length;
+    }
+
+    /**
+     * Returns the count of the cell, or 0 if it is not included.
+     */
+    public long get(long cell) {
+        int index = Arrays.binarySearch(cells, cell);
+        return index < 0 ? 0 : counts[index];
+    }
+
+    /**
+     * Sum of the counts.
+     */
+    public long total() {
+        long total = 0;
+        for (long count : counts) {
+            total += count;
+        }
+        return total;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        CellCounts that = (CellCounts) o;
+        return Arrays.equals(cells, that.cells) &&
+                Arrays.equals(counts, that.counts);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * Arrays.hashCode(cells) + Arrays.hashCode(counts);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("CellCounts{numCells=%d, total=%d}", cells.length, total());
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Boundaries of a set of cells, with each vertex shared by neighboring cells
+ * stored once.
+ *
+ * <p>Vertex <code>v</code> is at latitude <code>vertices[2 * v]</code> and longitude
+ * <code>vertices[2 * v + 1]</code>, in degrees. The boundary of cell <code>c</code> is
+ * the vertices <code>indices[offsets[c]]</code> to <code>indices[offsets[c + 1] - 1]</code>,
+ * counter-clockwise. The arrays are not copied, so they should not be modified.
+ */
+public class CellMesh {
+    public final double[] vertices;
+    public final int[] offsets;
+    public final int[] indices;
+
+    public CellMesh(double[] vertices, int[] offsets, int[] indices) {
+        this.vertices = vertices;
+        this.offsets = offsets;
+        this.indices = indices;
+    }
+
+    /**
+     * Number of unique vertices.
+     */
+    public int numVertices() {
+        return vertices.length / 2;
+    }
+
+    /**
+     * Number of cells, which is the number of inputs.
+     */
+    public int numCells() {
+        return offsets.length - 1;
+    }
+
+    /**
+     * Triangulates each cell boundary as a fan from its first vertex. Cell
+     * boundaries are close to convex, so the triangles cover each cell.
+     *
+     * @return Indices of the vertices of each triangle, three per triangle,
+     * counter-clockwise, ordered by cell.
+     */
+    public int[] triangles() {
+        int numTriangles = 0;
+        for (int c = 0; c < numCells(); c++) {
+            numTriangles += Math.max(0, offsets[c + 1] - offsets[c] - 2);
+        }
+
+        int[] triangles = new int[numTriangles * 3];
+        int t = 0;
+        for (int c = 0; c < numCells(); c++) {
+            for (int i = offsets[c] + 1; i + 1 < offsets[c + 1]; i++) {
+                triangles[t++] = indices[offsets[c]];
+                triangles[t++] = indices[i];
+                triangles[t++] = indices[i + 1];
+            }
+        }
+        return triangles;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        CellMesh that = (CellMesh) o;
+        return Arrays.equals(vertices, that.vertices) &&
+                Arrays.equals(offsets, that.offsets) &&
+                Arrays.equals(indices, that.indices);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * (31 * Arrays.hashCode(vertices) + Arrays.hashCode(offsets)) + Arrays.hashCode(indices);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("CellMesh{numCells=%d, numVertices=%d}", numCells(), numVertices());
+    }
+}
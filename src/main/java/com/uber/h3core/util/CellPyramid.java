@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Values of a set of indexes aggregated to each coarser resolution, in columnar form.
+ *
+ * <p>The levels are stored one after another from <code>minRes</code> to
+ * <code>maxRes</code>. Level <code>res</code> is the entries <code>levelOffsets[res - minRes]</code>
+ * to <code>levelOffsets[res - minRes + 1] - 1</code> of <code>cells</code>, <code>values</code>,
+ * and <code>counts</code>, with the cells sorted. <code>counts</code> is the number of input
+ * values combined into each cell.
+ *
+ * <p>The compacted coverage of level <code>res</code> is the entries
+ * <code>coverageOffsets[res - minRes]</code> to <code>coverageOffsets[res - minRes + 1] - 1</code>
+ * of <code>coverage</code>, sorted. It covers the same area as the cells of the level, with
+ * complete groups of children replaced by their parent, down to <code>minRes</code>.
+ *
+ * <p>The arrays are not copied, so they should not be modified.
+ */
+public class CellPyramid {
+    public final int minRes;
+    public final int maxRes;
+    public final long[] cells;
+    public final double[] values;
+    public final int[] counts;
+    public final int[] levelOffsets;
+    public final long[] coverage;
+    public final int[] coverageOffsets;
+
+    public CellPyramid(int minRes, int maxRes, long[] cells, double[] values, int[] counts, int[] levelOffsets,
+                       long[] coverage, int[] coverageOffsets) {
+        this.minRes = minRes;
+        this.maxRes = maxRes;
+        this.cells = cells;
+        this.values = values;
+        this.counts = counts;
+        this.levelOffsets = levelOffsets;
+        this.coverage = coverage;
+        this.coverageOffsets = coverageOffsets;
+    }
+
+    /**
+     * Number of cells of the level.
+     */
+    public int levelSize(int res) {
+        return levelOffsets[res - minRes + 1] - levelOffsets[res - minRes];
+    }
+
+    /**
+     * Returns a copy of the cells of the level.
+     */
+    public long[] level(int res) {
+        return Arrays.copyOfRange(cells, levelOffsets[res - minRes], levelOffsets[res - minRes + 1]);
+    }
+
+    /**
+     * Returns a copy of the compacted coverage of the level.
+     */
+    public long[] coverage(int res) {
+        return Arrays.copyOfRange(coverage, coverageOffsets[res - minRes], coverageOffsets[res - minRes + 1]);
+    }
+
+    /**
+     * Finds the position of the cell in the columns, searching the level of the given
+     * resolution.
+     *
+     * @return Position of the cell in <code>cells</code>, <code>values</code>, and
+     *         <code>counts</code>, or -1 if it is not in the level
+     */
+    public int indexOf(int res, long cell) {
+        int index = Arrays.binarySearch(cells, levelOffsets[res - minRes], levelOffsets[res - minRes + 1], cell);
+        return index >= 0 ? index : -1;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        CellPyramid that = (CellPyramid) o;
+        return minRes == that.minRes &&
+                maxRes == that.maxRes &&
+                Arrays.equals(cells, that.cells) &&
+                Arrays.equals(values, that.values) &&
+                Arrays.equals(counts, that.counts) &&
+                Arrays.equals(levelOffsets, that.levelOffsets) &&
+                Arrays.equals(coverage, that.coverage) &&
+                Arrays.equals(coverageOffsets, that.coverageOffsets);
+    }
+
+    @Override
+    public int hashCode() {
+        int result = 31 * minRes + maxRes;
+        result = 31 * result + Arrays.hashCode(cells);
+        result = 31 * result + Arrays.hashCode(values);
+        result = 31 * result + Arrays.hashCode(counts);
+        result = 31 * result + Arrays.hashCode(levelOffsets);
+        result = 31 * result + Arrays.hashCode(coverage);
+        return 31 * result + Arrays.hashCode(coverageOffsets);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("CellPyramid{minRes=%d, maxRes=%d, numCells=%d, numCoverage=%d}",
+                minRes, maxRes, cells.length, coverage.length);
+    }
+}
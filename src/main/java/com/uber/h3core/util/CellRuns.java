@@ -0,0 +1,82 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Trajectories as run-length encoded sequences of cells.
+ *
+ * <p>Run <code>i</code> is <code>counts[i]</code> consecutive points in
+ * <code>cells[i]</code>, the first of which was at <code>entryTimes[i]</code>. Runs
+ * filling a gap between points have a count of 0. The runs of trajectory
+ * <code>t</code> are <code>offsets[t]</code> to <code>offsets[t + 1] - 1</code>. The
+ * arrays are not copied, so they should not be modified.
+ */
+public class CellRuns {
+    public final long[] cells;
+    public final int[] counts;
+    public final long[] entryTimes;
+    public final int[] offsets;
+
+    public CellRuns(long[] cells, int[] counts, long[] entryTimes, int[] offsets) {
+        this.cells = cells;
+        this.counts = counts;
+        this.entryTimes = entryTimes;
+        this.offsets = offsets;
+    }
+
+    /**
+     * Number of trajectories.
+     */
+    public int numTrajectories() {
+        return offsets.length - 1;
+    }
+
+    /**
+     * Number of runs in all trajectories.
+     */
+    public int numRuns() {
+        return cells.length;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        CellRuns cellRuns = (CellRuns) o;
+        return Arrays.equals(cells, cellRuns.cells) &&
+                Arrays.equals(counts, cellRuns.counts) &&
+                Arrays.equals(entryTimes, cellRuns.entryTimes) &&
+                Arrays.equals(offsets, cellRuns.offsets);
+    }
+
+    @Override
+    public int hashCode() {
+        int result = Arrays.hashCode(cells);
+        result = 31 * result + Arrays.hashCode(counts);
+        result = 31 * result + Arrays.hashCode(entryTimes);
+        result = 31 * result + Arrays.hashCode(offsets);
+        return result;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("CellRuns{cells=%s, counts=%s, entryTimes=%s, offsets=%s}",
+                Arrays.toString(cells), Arrays.toString(counts), Arrays.toString(entryTimes),
+                Arrays.toString(offsets));
+    }
+}
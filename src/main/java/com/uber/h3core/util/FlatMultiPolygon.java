@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Polygons in compressed sparse row form, as taken by
+ * {@link com.uber.h3core.H3Core#polyfillBatch(double[], int[], int[], int)}.
+ *
+ * <p>Vertex <code>v</code> is at latitude <code>verts[2 * v]</code> and longitude
+ * <code>verts[2 * v + 1]</code>, in degrees. Ring <code>r</code> has the vertices
+ * <code>ringOffsets[r]</code> to <code>ringOffsets[r + 1] - 1</code>, and is not
+ * closed by repeating its first vertex. Polygon <code>p</code> has the rings
+ * <code>polygonOffsets[p]</code> to <code>polygonOffsets[p + 1] - 1</code>, of which
+ * the first is the outline and the rest are holes. The arrays are not copied, so
+ * they should not be modified.
+ */
+public class FlatMultiPolygon {
+    public final double[] verts;
+    public final int[] ringOffsets;
+    public final int[] polygonOffsets;
+
+    public FlatMultiPolygon(double[] verts, int[] ringOffsets, int[] polygonOffsets) {
+        this.verts = verts;
+        this.ringOffsets = ringOffsets;
+        this.polygonOffsets = polygonOffsets;
+    }
+
+    /**
+     * Number of polygons.
+     */
+    public int numPolygons() {
+        return polygonOffsets.length - 1;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        FlatMultiPolygon that = (FlatMultiPolygon) o;
+        return Arrays.equals(verts, that.verts) &&
+                Arrays.equals(ringOffsets, that.ringOffsets) &&
+                Arrays.equals(polygonOffsets, that.polygonOffsets);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * (31 * Arrays.hashCode(verts) + Arrays.hashCode(ringOffsets)) + Arrays.hashCode(polygonOffsets);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("FlatMultiPolygon{numPolygons=%d, numRings=%d, numVerts=%d}",
+                numPolygons(), ringOffsets.length - 1, verts.length / 2);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Counts of origin and destination pairs, in columnar form, sorted by origin and then
+ * destination. The arrays are not copied, so they should not be modified.
+ */
+public class FlowCounts {
+    public final long[] origins;
+    public final long[] destinations;
+    public final long[] counts;
+
+    public FlowCounts(long[] origins, long[] destinations, long[] counts) {
+        this.origins = origins;
+        this.destinations = destinations;
+        this.counts = counts;
+    }
+
+    /**
+     * Number of pairs.
+     */
+    public int size() {
+        return origins.length;
+    }
+
+    /**
+     * Returns the count of the pair, or 0 if it is not included.
+     */
+    public long get(long origin, long destination) {
+        int low = 0;
+        int high = origins.length - 1;
+        while (low <= high) {
+            int mid = (low + high) >>> 1;
+            int cmp = origins[mid] != origin ? Long.compare(origins[mid], origin)
+                    : Long.compare(destinations[mid], destination);
+            if (cmp < 0) {
+                low = mid + 1;
+            } else if (cmp > 0) {
+                high = mid - 1;
+            } else {
+                return counts[mid];
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Sum of the counts.
+     */
+    public long total() {
+        long total = 0;
+        for (long count : counts) {
+            total += count;
+        }
+        return total;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        FlowCounts that = (FlowCounts) o;
+        return Arrays.equals(origins, that.origins) &&
+                Arrays.equals(destinations, that.destinations) &&
+                Arrays.equals(counts, that.counts);
+    }
+
+    @Override
+    public int hashCode() {
+        int result = Arrays.hashCode(origins);
+        result = 31 * result + Arrays.hashCode(destinations);
+        result = 31 * result + Arrays.hashCode(counts);
+        return result;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("FlowCounts{numPairs=%d, total=%d}", origins.length, total());
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Geofences an entity entered and exited, by their index in the order the geofences were
+ * given, sorted. The arrays are not copied, so they should not be modified.
+ */
+public class GeofenceDelta {
+    /**
+     * No change, returned without allocating when an entity stays in its geofences.
+     */
+    public static final GeofenceDelta EMPTY = new GeofenceDelta(new int[0], new int[0]);
+
+    public final int[] entered;
+    public final int[] exited;
+
+    public GeofenceDelta(int[] entered, int[] exited) {
+        this.entered = entered;
+        this.exited = exited;
+    }
+
+    /**
+     * Returns true if no geofences were entered or exited.
+     */
+    public boolean isEmpty() {
+        return entered.length == 0 && exited.length == 0;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        GeofenceDelta that = (GeofenceDelta) o;
+        return Arrays.equals(entered, that.entered) &&
+                Arrays.equals(exited, that.exited);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * Arrays.hashCode(entered) + Arrays.hashCode(exited);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("GeofenceDelta{entered=%s, exited=%s}", Arrays.toString(entered),
+                Arrays.toString(exited));
+    }
+}
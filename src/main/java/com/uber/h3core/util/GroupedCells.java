@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * Cells for each of a number of inputs, in compressed sparse row form.
+ *
+ * <p>The cells for input <code>g</code> are <code>cells[offsets[g]]</code> to
+ * <code>cells[offsets[g + 1] - 1]</code>. The arrays are not copied, so they should
+ * not be modified.
+ */
+public class GroupedCells {
+    public final long[] cells;
+    public final int[] offsets;
+
+    public GroupedCells(long[] cells, int[] offsets) {
+        this.cells = cells;
+        this.offsets = offsets;
+    }
+
+    /**
+     * Number of groups, which is the number of inputs.
+     */
+    public int numGroups() {
+        return offsets.length - 1;
+    }
+
+    /**
+     * Number of cells in the group.
+     */
+    public int groupSize(int group) {
+        return offsets[group + 1] - offsets[group];
+    }
+
+    /**
+     * Returns a copy of the cells in the group.
+     */
+    public long[] group(int group) {
+        return Arrays.copyOfRange(cells, offsets[group], offsets[group + 1]);
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        GroupedCells that = (GroupedCells) o;
+        return Arrays.equals(cells, that.cells) &&
+                Arrays.equals(offsets, that.offsets);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * Arrays.hashCode(cells) + Arrays.hashCode(offsets);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("GroupedCells{numGroups=%d, numCells=%d}", numGroups(), cells.length);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+import java.util.Arrays;
+
+/**
+ * The boundary of a set of cells. The arrays are not copied, so they should not be
+ * modified.
+ */
+public class RegionBoundary {
+    /**
+     * Unidirectional edges from a cell in the set to a cell outside it.
+     */
+    public final long[] edges;
+    /**
+     * Cells in the set with at least one neighbor outside it.
+     */
+    public final long[] boundaryCells;
+    /**
+     * Cells outside the set with at least one neighbor in it.
+     */
+    public final long[] exteriorCells;
+
+    public RegionBoundary(long[] edges, long[] boundaryCells, long[] exteriorCells) {
+        this.edges = edges;
+        this.boundaryCells = boundaryCells;
+        this.exteriorCells = exteriorCells;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        RegionBoundary that = (RegionBoundary) o;
+        return Arrays.equals(edges, that.edges) &&
+                Arrays.equals(boundaryCells, that.boundaryCells) &&
+                Arrays.equals(exteriorCells, that.exteriorCells);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * (31 * Arrays.hashCode(edges) + Arrays.hashCode(boundaryCells)) +
+                Arrays.hashCode(exteriorCells);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("RegionBoundary{numEdges=%d, numBoundaryCells=%d, numExteriorCells=%d}",
+                edges.length, boundaryCells.length, exteriorCells.length);
+    }
+}
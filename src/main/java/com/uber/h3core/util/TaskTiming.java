@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.util;
+
+/**
+ * How long one task of a batch operation took, for finding where the time of the batch
+ * went.
+ */
+public class TaskTiming {
+    /**
+     * Input the task worked on, such as the index of a polygon.
+     */
+    public final int input;
+    /**
+     * Index of the task among those for the same input.
+     */
+    public final int task;
+    /**
+     * Number of cells the task found.
+     */
+    public final int numCells;
+    /**
+     * Time the task took to run, in nanoseconds.
+     */
+    public final long nanos;
+
+    public TaskTiming(int input, int task, int numCells, long nanos) {
+        this.input = input;
+        this.task = task;
+        this.numCells = numCells;
+        this.nanos = nanos;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (o == null || getClass() != o.getClass()) return false;
+        TaskTiming that = (TaskTiming) o;
+        return input == that.input &&
+                task == that.task &&
+                numCells == that.numCells &&
+                nanos == that.nanos;
+    }
+
+    @Override
+    public int hashCode() {
+        int result = input;
+        result = 31 * result + task;
+        result = 31 * result + numCells;
+        result = 31 * result + Long.hashCode(nanos);
+        return result;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("TaskTiming{input=%d, task=%d, numCells=%d, nanos=%d}", input, task, numCells, nanos);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.util.CellCounts;
+import org.junit.Test;
+
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests for {@link ConcurrentCellCounter}.
+ */
+public class TestConcurrentCellCounter extends BaseTestH3Core {
+    @Test
+    public void testConcurrentIncrements() throws InterruptedException {
+        List<Long> cells = h3.kRing(h3.geoToH3(37.775, -122.418, 9), 10);
+        ConcurrentCellCounter counter = new ConcurrentCellCounter(cells.size(), 4);
+
+        Thread[] threads = new Thread[8];
+        for (int t = 0; t < threads.length; t++) {
+            threads[t] = new Thread(() -> {
+                for (int round = 0; round < 100; round++) {
+                    for (long cell : cells) {
+                        counter.increment(cell);
+                    }
+                }
+            });
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+
+        assertEquals(cells.size(), counter.size());
+        CellCounts snapshot = counter.snapshot();
+        assertEquals(cells.size(), snapshot.size());
+        for (long cell : cells) {
+            assertEquals(800, counter.get(cell));
+            assertEquals(800, snapshot.get(cell));
+        }
+        for (int i = 1; i < snapshot.size(); i++) {
+            assertTrue(snapshot.cells[i - 1] < snapshot.cells[i]);
+        }
+        assertEquals(0, counter.get(h3.geoToH3(0, 0, 9)));
+    }
+
+    @Test
+    public void testDecay() {
+        long a = h3.geoToH3(37.775, -122.418, 9);
+        long b = h3.geoToH3(37.5, -122, 9);
+        ConcurrentCellCounter counter = new ConcurrentCellCounter(10, 1);
+        counter.add(a, 100);
+        counter.add(b, 1);
+
+        counter.decay(0.5);
+
+        assertEquals(50, counter.get(a));
+        assertEquals(0, counter.get(b));
+        CellCounts snapshot = counter.snapshot();
+        assertArrayEquals("Zero counts are not included", new long[] {a}, snapshot.cells);
+        assertEquals(2, counter.size());
+    }
+
+    @Test
+    public void testRollUp() {
+        long cell = h3.geoToH3(37.775, -122.418, 9);
+        ConcurrentCellCounter counter = new ConcurrentCellCounter(100);
+        Map<Long, Long> expected = new HashMap<>();
+        for (long child : h3.kRing(cell, 3)) {
+            counter.add(child, 3);
+            expected.merge(h3.h3ToParent(child, 7), 3L, Long::sum);
+        }
+
+        CellCounts rolledUp = counter.rollUp(h3, 7);
+
+        assertEquals(expected.size(), rolledUp.size());
+        for (Map.Entry<Long, Long> entry : expected.entrySet()) {
+            assertEquals((long) entry.getValue(), rolledUp.get(entry.getKey()));
+        }
+        assertEquals(37 * 3, rolledUp.total());
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testFull() {
+        ConcurrentCellCounter counter = new ConcurrentCellCounter(4, 1);
+        for (long cell : h3.kRing(h3.geoToH3(37.775, -122.418, 9), 2)) {
+            counter.increment(cell);
+        }
+    }
+
+    @Test(timeout = 60000)
+    public void testConcurrentFill() throws InterruptedException {
+        // Racing threads must not fill every slot, or lookups of absent indexes never end
+        List<Long> cells = h3.kRing(h3.geoToH3(37.775, -122.418, 9), 10);
+        for (int attempt = 0; attempt < 200; attempt++) {
+            ConcurrentCellCounter counter = new ConcurrentCellCounter(1, 1);
+            Thread[] threads = new Thread[8];
+            for (int t = 0; t < threads.length; t++) {
+                long cell = cells.get(t);
+                threads[t] = new Thread(() -> {
+                    try {
+                        counter.increment(cell);
+                    } catch (IllegalStateException e) {
+                        // Full
+                    }
+                });
+                threads[t].start();
+            }
+            for (Thread thread : threads) {
+                thread.join();
+            }
+
+            assertEquals(1, counter.size());
+            assertEquals(1, counter.snapshot().total());
+            assertEquals(0, counter.get(h3.geoToH3(0, 0, 9)));
+        }
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testInvalid() {
+        new ConcurrentCellCounter(4).increment(0);
+    }
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.exceptions.PentagonEncounteredException;
+import com.uber.h3core.util.FlatMultiPolygon;
+import com.uber.h3core.util.GeoCoord;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+import java.util.Set;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests for {@link DynamicOutline}.
+ */
+public class TestDynamicOutline extends BaseTestH3Core {
+    @Test
+    public void testRingAndCenter() throws PentagonEncounteredException {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        DynamicOutline outline = h3.newDynamicOutline();
+        for (long cell : h3.hexRing(center, 1)) {
+            assertTrue(outline.add(cell));
+        }
+
+        List<List<List<GeoCoord>>> ring = outline.toMultiPolygon(false);
+        assertEquals(1, ring.size());
+        assertEquals(2, ring.get(0).size());
+        assertEquals(6 * 3, ring.get(0).get(0).size());
+        assertEquals(6, ring.get(0).get(1).size());
+
+        assertTrue(outline.add(center));
+        assertFalse(outline.add(center));
+        List<List<List<GeoCoord>>> disk = outline.toMultiPolygon(false);
+        assertEquals(1, disk.size());
+        assertEquals(1, disk.get(0).size());
+
+        assertTrue(outline.remove(center));
+        assertFalse(outline.remove(center));
+        assertEquals(vertexCounts(ring), vertexCounts(outline.toMultiPolygon(false)));
+
+        for (long cell : h3.hexRing(center, 1)) {
+            assertTrue(outline.remove(cell));
+        }
+        assertEquals(0, outline.size());
+        assertTrue(outline.toMultiPolygon(false).isEmpty());
+    }
+
+    @Test
+    public void testMatchesH3SetToMultiPolygon() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        List<Long> disk = h3.kRing(center, 4);
+        Set<Long> cells = new HashSet<>();
+        DynamicOutline outline = h3.newDynamicOutline();
+        Random random = new Random(0);
+
+        for (int i = 0; i < 200; i++) {
+            long cell = disk.get(random.nextInt(disk.size()));
+            if (cells.add(cell)) {
+                outline.add(cell);
+            } else {
+                cells.remove(cell);
+                outline.remove(cell);
+            }
+
+            if (i % 20 == 0) {
+                assertEquals(cells.size(), outline.size());
+                // Where loops touch, they may be split differently, but have the same vertices
+                assertEquals("Outline after " + i + " changes",
+                        vertexCounts(h3.h3SetToMultiPolygon(cells, false)),
+                        vertexCounts(outline.toMultiPolygon(false)));
+            }
+        }
+    }
+
+    @Test
+    public void testDisksJoin() {
+        // Shared vertices computed from each cell should always be matched, wherever they are
+        Random random = new Random(0);
+        for (int i = 0; i < 200; i++) {
+            double lat = random.nextDouble() * 160 - 80;
+            double lng = random.nextDouble() * 360 - 180;
+            long center = h3.geoToH3(lat, lng, 10);
+            List<Long> disk = h3.kRing(center, 2);
+            if (disk.stream().anyMatch(cell -> h3.h3IsPentagon(cell))) {
+                continue;
+            }
+            DynamicOutline outline = h3.newDynamicOutline();
+            disk.forEach(outline::add);
+            List<List<List<GeoCoord>>> polygons = outline.toMultiPolygon(false);
+            assertEquals("disk at " + lat + ", " + lng, 1, polygons.size());
+            assertEquals(1, polygons.get(0).size());
+            assertEquals(6 * 5, polygons.get(0).get(0).size());
+        }
+    }
+
+    @Test
+    public void testAntimeridian() {
+        DynamicOutline outline = h3.newDynamicOutline();
+        for (long cell : h3.kRing(h3.geoToH3(0, 180, 4), 1)) {
+            outline.add(cell);
+        }
+        List<List<List<GeoCoord>>> polygons = outline.toMultiPolygon(false);
+        assertEquals(1, polygons.size());
+        assertEquals(1, polygons.get(0).size());
+        assertEquals(6 * 3, polygons.get(0).get(0).size());
+    }
+
+    @Test
+    public void testToFlatAndWkb() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        DynamicOutline outline = h3.newDynamicOutline();
+        outline.add(center);
+        outline.add(h3.geoToH3(37.5, -122, 9));
+
+        FlatMultiPolygon flat = outline.toFlat();
+        assertEquals(2, flat.numPolygons());
+        assertEquals(3, flat.ringOffsets.length);
+        assertEquals(12, flat.verts.length / 2);
+
+        ByteBuffer wkb = ByteBuffer.wrap(outline.toWkb()).order(ByteOrder.LITTLE_ENDIAN);
+        assertEquals(1, wkb.get());
+        assertEquals(6, wkb.getInt());
+        assertEquals(2, wkb.getInt());
+        assertEquals(1, wkb.get());
+        assertEquals(3, wkb.getInt());
+        assertEquals(1, wkb.getInt());
+        // Closed ring
+        assertEquals(7, wkb.getInt());
+        assertEquals(flat.verts[1], wkb.getDouble(), EPSILON);
+        assertEquals(flat.verts[0], wkb.getDouble(), EPSILON);
+        assertEquals(9 + 2 * (9 + 4 + 7 * 16), wkb.capacity());
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testMixedResolutions() {
+        DynamicOutline outline = h3.newDynamicOutline();
+        outline.add(h3.geoToH3(0, 0, 5));
+        outline.add(h3.geoToH3(0, 0, 6));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testInvalid() {
+        h3.newDynamicOutline().add(0);
+    }
+
+    /**
+     * Number of times each vertex, rounded, appears in the polygons.
+     */
+    private static Map<String, Integer> vertexCounts(List<List<List<GeoCoord>>> polygons) {
+        Map<String, Integer> counts = new HashMap<>();
+        for (List<List<GeoCoord>> polygon : polygons) {
+            for (List<GeoCoord> loop : polygon) {
+                for (GeoCoord coord : loop) {
+                    counts.merge(String.format("%.6f,%.6f", coord.lat, coord.lng), 1, Integer::sum);
+                }
+            }
+        }
+        return counts;
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.exceptions.LineUndefinedException;
+import com.uber.h3core.util.CellCounts;
+import com.uber.h3core.util.FlowCounts;
+import org.junit.Test;
+
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests for {@link FlowAggregator}.
+ */
+public class TestFlowAggregator extends BaseTestH3Core {
+    @Test
+    public void testFlowsAndEdges() throws LineUndefinedException {
+        FlowAggregator aggregator = h3.newFlowAggregator(9, true);
+        aggregator.add(new double[] {37.775, -122.418, 37.775, -122.418, 37.79, -122.39},
+                new double[] {37.79, -122.39, 37.79, -122.39, 37.79, -122.39});
+        long origin = h3.geoToH3(37.775, -122.418, 9);
+        long destination = h3.geoToH3(37.79, -122.39, 9);
+
+        FlowCounts flows = aggregator.flowCounts();
+        assertEquals(2, flows.size());
+        assertEquals(3, flows.total());
+        assertEquals(2, flows.get(origin, destination));
+        assertEquals(1, flows.get(destination, destination));
+        assertEquals(0, flows.get(destination, origin));
+        assertTrue(flows.origins[0] < flows.origins[1]);
+
+        List<Long> line = h3.h3Line(origin, destination);
+        CellCounts edges = aggregator.edgeCounts();
+        assertEquals(line.size() - 1, edges.size());
+        for (int i = 1; i < line.size(); i++) {
+            assertEquals(2, edges.get(h3.getH3UnidirectionalEdge(line.get(i - 1), line.get(i))));
+        }
+        assertEquals(0, aggregator.getUnroutedTrips());
+    }
+
+    @Test
+    public void testMerge() {
+        long center = h3.geoToH3(37.775, -122.418, 8);
+        List<Long> disk = h3.kRing(center, 5);
+        Random random = new Random(0);
+        FlowAggregator all = h3.newFlowAggregator(8, true);
+        FlowAggregator first = h3.newFlowAggregator(8, true);
+        FlowAggregator second = h3.newFlowAggregator(8, true);
+        Map<String, Long> expected = new HashMap<>();
+
+        for (int batch = 0; batch < 20; batch++) {
+            long[] origins = new long[200];
+            long[] destinations = new long[200];
+            for (int i = 0; i < origins.length; i++) {
+                origins[i] = disk.get(random.nextInt(disk.size()));
+                destinations[i] = disk.get(random.nextInt(disk.size()));
+                expected.merge(origins[i] + ":" + destinations[i], 1L, Long::sum);
+            }
+            all.add(origins, destinations);
+            (batch % 2 == 0 ? first : second).add(origins, destinations);
+        }
+        first.merge(second);
+
+        FlowCounts flows = first.flowCounts();
+        assertEquals(all.flowCounts(), flows);
+        assertEquals(all.edgeCounts(), first.edgeCounts());
+        assertEquals(expected.size(), flows.size());
+        for (int i = 0; i < flows.size(); i++) {
+            assertEquals((long) expected.get(flows.origins[i] + ":" + flows.destinations[i]), flows.counts[i]);
+        }
+    }
+
+    @Test
+    public void testWithoutEdges() {
+        FlowAggregator aggregator = h3.newFlowAggregator(9, false);
+        aggregator.add(new double[] {37.775, -122.418}, new double[] {37.79, -122.39});
+        assertEquals(1, aggregator.flowCounts().total());
+        assertEquals(0, aggregator.edgeCounts().size());
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testMergeDifferentResolution() {
+        h3.newFlowAggregator(9, true).merge(h3.newFlowAggregator(8, true));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testWrongResolution() {
+        long cell = h3.geoToH3(37.775, -122.418, 8);
+        h3.newFlowAggregator(9, false).add(new long[] {cell}, new long[] {cell});
+    }
+}
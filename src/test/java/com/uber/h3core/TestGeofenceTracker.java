@@ -0,0 +1,156 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import com.uber.h3core.util.GeofenceDelta;
+import com.uber.h3core.util.GroupedCells;
+import org.junit.Test;
+
+import java.util.HashSet;
+import java.util.List;
+import java.util.Random;
+import java.util.Set;
+import java.util.TreeSet;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+
+/**
+ * Tests for {@link GeofenceTracker}.
+ */
+public class TestGeofenceTracker extends BaseTestH3Core {
+    @Test
+    public void testEnterAndExit() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long parent = h3.h3ToParent(center, 7);
+        GeofenceTracker tracker = h3.newGeofenceTracker(fences(center, parent), 9);
+
+        assertSame(GeofenceDelta.EMPTY, tracker.update(1, 0, 0));
+        assertEquals(1, tracker.size());
+        assertArrayEquals(new int[0], tracker.geofences(1));
+
+        GeofenceDelta delta = tracker.update(1, center);
+        assertArrayEquals(new int[] {0, 1}, delta.entered);
+        assertArrayEquals(new int[0], delta.exited);
+        assertArrayEquals(new int[] {0, 1}, tracker.geofences(1));
+        // Staying in the cell does nothing
+        assertSame(GeofenceDelta.EMPTY, tracker.update(1, 37.775, -122.418));
+
+        delta = tracker.update(1, h3.geoToH3(0, 0, 9));
+        assertArrayEquals(new int[0], delta.entered);
+        assertArrayEquals(new int[] {0, 1}, delta.exited);
+
+        tracker.update(2, center);
+        assertEquals(2, tracker.size());
+        assertEquals(new GeofenceDelta(new int[0], new int[] {0, 1}), tracker.remove(2));
+        assertSame(GeofenceDelta.EMPTY, tracker.remove(2));
+        assertEquals(1, tracker.size());
+    }
+
+    @Test
+    public void testFirstSeenOutside() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long parent = h3.h3ToParent(center, 7);
+        GeofenceTracker tracker = h3.newGeofenceTracker(fences(center, parent), 9);
+
+        assertSame(GeofenceDelta.EMPTY, tracker.update(1, 0, 0));
+        assertSame(GeofenceDelta.EMPTY, tracker.update(1, 1, 1));
+        assertArrayEquals(new int[] {0, 1}, tracker.update(1, center).entered);
+
+        assertSame(GeofenceDelta.EMPTY, tracker.update(2, 0, 0));
+        assertSame(GeofenceDelta.EMPTY, tracker.remove(2));
+        assertArrayEquals(new int[0], tracker.geofences(2));
+        assertEquals(1, tracker.size());
+    }
+
+    @Test
+    public void testRandomWalks() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long parent = h3.h3ToParent(center, 7);
+        GeofenceTracker tracker = h3.newGeofenceTracker(fences(center, parent), 9);
+        Set<Long> disk = new HashSet<>(h3.kRing(center, 1));
+        List<Long> area = h3.kRing(center, 20);
+
+        int numEntities = 3000;
+        long[] positions = new long[numEntities];
+        Random random = new Random(0);
+        for (int i = 0; i < 20 * numEntities; i++) {
+            int entity = random.nextInt(numEntities);
+            long cell = random.nextInt(4) == 0 ? positions[entity] : area.get(random.nextInt(area.size()));
+            if (cell == 0) {
+                cell = center;
+            }
+            Set<Integer> before = positions[entity] == 0 ? new TreeSet<>() : expected(positions[entity], disk, parent);
+            Set<Integer> after = expected(cell, disk, parent);
+            positions[entity] = cell;
+
+            Set<Integer> entered = new TreeSet<>(after);
+            entered.removeAll(before);
+            Set<Integer> exited = new TreeSet<>(before);
+            exited.removeAll(after);
+            GeofenceDelta delta = tracker.update(entity, cell);
+            assertArrayEquals(toArray(entered), delta.entered);
+            assertArrayEquals(toArray(exited), delta.exited);
+            assertArrayEquals(toArray(after), tracker.geofences(entity));
+
+            if (random.nextInt(10) == 0) {
+                assertArrayEquals(toArray(after), tracker.remove(entity).exited);
+                positions[entity] = 0;
+            }
+        }
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testFinerGeofence() {
+        long cell = h3.geoToH3(37.775, -122.418, 10);
+        h3.newGeofenceTracker(new GroupedCells(new long[] {cell}, new int[] {0, 1}), 9);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testWrongResolution() {
+        GeofenceTracker tracker = h3.newGeofenceTracker(new GroupedCells(new long[0], new int[] {0}), 9);
+        tracker.update(1, h3.geoToH3(37.775, -122.418, 8));
+    }
+
+    /**
+     * Geofence 0 is the compacted disk around the center, and 1 is the parent.
+     */
+    private GroupedCells fences(long center, long parent) {
+        List<Long> disk = h3.compact(h3.kRing(center, 1));
+        long[] cells = new long[disk.size() + 1];
+        for (int i = 0; i < disk.size(); i++) {
+            cells[i] = disk.get(i);
+        }
+        cells[disk.size()] = parent;
+        return new GroupedCells(cells, new int[] {0, disk.size(), disk.size() + 1});
+    }
+
+    private Set<Integer> expected(long cell, Set<Long> disk, long parent) {
+        Set<Integer> fences = new TreeSet<>();
+        if (disk.contains(cell)) {
+            fences.add(0);
+        }
+        if (h3.h3ToParent(cell, 7) == parent) {
+            fences.add(1);
+        }
+        return fences;
+    }
+
+    private static int[] toArray(Set<Integer> set) {
+        return set.stream().mapToInt(Integer::intValue).toArray();
+    }
+}
@@ -19,12 +19,15 @@ import org.junit.Test;
 
 import java.io.IOException;
 import java.util.Collection;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.TimeUnit;
 
 import com.uber.h3core.util.GeoCoord;
 
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertNotEquals;
 import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertSame;
 import static org.junit.Assert.assertTrue;
 
 /**
@@ -55,6 +58,15 @@ public class TestH3Core extends BaseTestH3Core {
         assertNotNull(another);
     }
 
+    @Test
+    public void testWarmup() throws Exception {
+        CompletableFuture<Void> warmup = h3.warmup();
+        assertSame("Warmup is started once", warmup, H3Core.newInstance().warmup());
+
+        warmup.get(5, TimeUnit.MINUTES);
+        assertTrue(h3.isWarmedUp());
+    }
+
     @Test
     public void testConstants() {
         double lastAreaKm2 = 0;
@@ -154,6 +166,18 @@ public class TestH3Core extends BaseTestH3Core {
         h3.cellArea(0, AreaUnit.rads2);
     }
 
+    @Test
+    public void testCellAreaBatch() {
+        long[] cells = {h3.geoToH3(37.775, -122.418, 9), 0x821c07fffffffffL, 0};
+        for (AreaUnit unit : AreaUnit.values()) {
+            double[] areas = h3.cellArea(cells, unit);
+
+            assertEquals(h3.cellArea(cells[0], unit), areas[0], 0);
+            assertEquals(h3.cellArea(cells[1], unit), areas[1], 0);
+            assertEquals(0, areas[2], 0);
+        }
+    }
+
     @Test(expected = IllegalArgumentException.class)
     public void testCellAreaInvalidUnit() {
         long cell = h3.geoToH3(0, 0, 0);
@@ -21,6 +21,9 @@ import java.io.File;
 import java.io.IOException;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
 
 /**
  * H3CoreLoader is mostly tested by {@link TestH3Core}. This also tests OS detection.
@@ -71,4 +74,29 @@ public class TestH3CoreLoader {
 
         H3CoreLoader.copyResource("/nonexistant-resource", tempFile);
     }
+
+    @Test
+    public void testIsNativeImage() {
+        assertFalse("Tests run on a JVM", H3CoreLoader.isNativeImage());
+    }
+
+    @Test
+    public void testCheckpointAndRestore() throws IOException {
+        H3Core h3 = H3Core.newInstance();
+        File before = H3CoreLoader.getLibraryFile();
+        assertTrue(before.exists());
+        assertTrue("org.crac is on the test class path", LibraryCheckpointResource.isRegistered());
+
+        H3CoreLoader.beforeCheckpoint();
+        assertFalse("Extracted library is removed from the checkpoint", before.exists());
+        H3CoreLoader.afterRestore();
+
+        // The mapped library is used without the file, by existing and new instances, and
+        // is not extracted or loaded again
+        assertEquals(0x8928308280fffffL, h3.geoToH3(37.775938728915946, -122.41795063018799, 9));
+        H3Core restored = H3Core.newInstance();
+        assertSame(before, H3CoreLoader.getLibraryFile());
+        assertFalse(before.exists());
+        assertEquals(0x8928308280fffffL, restored.geoToH3(37.775938728915946, -122.41795063018799, 9));
+    }
 }
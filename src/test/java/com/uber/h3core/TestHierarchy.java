@@ -16,13 +16,17 @@
 package com.uber.h3core;
 
 import com.google.common.collect.ImmutableList;
+import com.uber.h3core.util.CellPyramid;
 import org.junit.Test;
 
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collection;
 import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertTrue;
 
@@ -39,6 +43,15 @@ public class TestHierarchy extends BaseTestH3Core {
         assertEquals("872830828ffffff", h3.h3ToParentAddress("8928308280fffff", 7));
     }
 
+    @Test
+    public void testH3ToParentBatch() {
+        long[] cells = {0x811d7ffffffffffL, 0x8928308280fffffL, 0x801dfffffffffffL, 0};
+
+        assertArrayEquals(new long[] {0x801dfffffffffffL, 0x8029fffffffffffL,
+                0x801dfffffffffffL, 0}, h3.h3ToParent(cells, 0));
+        assertArrayEquals(new long[] {0, 0x872830828ffffffL, 0, 0}, h3.h3ToParent(cells, 7));
+    }
+
     @Test(expected = IllegalArgumentException.class)
     public void testH3ToParentInvalidRes() {
         h3.h3ToParent(0, 5);
@@ -173,4 +186,79 @@ public class TestHierarchy extends BaseTestH3Core {
     public void testH3ToCenterChildOutOfRange() {
         h3.h3ToCenterChild("8928308280fffff", 16);
     }
+
+    @Test
+    public void testBuildPyramid() {
+        long parent = h3.geoToH3(37.775, -122.418, 7);
+        List<Long> children = h3.h3ToChildren(parent, 9);
+        // All of the children, and one more index under a different parent
+        long other = h3.geoToH3(40.7, -74, 9);
+        long[] cells = new long[children.size() + 1];
+        double[] values = new double[cells.length];
+        for (int i = 0; i < children.size(); i++) {
+            cells[i] = children.get(children.size() - 1 - i);
+            values[i] = i;
+        }
+        cells[children.size()] = other;
+        values[children.size()] = 1000;
+
+        CellPyramid pyramid = h3.buildPyramid(cells, values, 6, Aggregation.sum);
+        assertEquals(6, pyramid.minRes);
+        assertEquals(9, pyramid.maxRes);
+        assertEquals(49 + 1, pyramid.levelSize(9));
+        assertEquals(7 + 1, pyramid.levelSize(8));
+        assertEquals(2, pyramid.levelSize(7));
+        assertEquals(2, pyramid.levelSize(6));
+
+        int index = pyramid.indexOf(7, parent);
+        assertEquals(49 * 48 / 2, pyramid.values[index], EPSILON);
+        assertEquals(49, pyramid.counts[index]);
+        assertEquals(-1, pyramid.indexOf(7, h3.h3ToParent(parent, 6)));
+        long[] level = pyramid.level(9);
+        long[] sorted = level.clone();
+        Arrays.sort(sorted);
+        assertArrayEquals(sorted, level);
+
+        // The complete parent replaces its children in the coverage
+        assertEquals(new HashSet<>(Arrays.asList(parent, other)), toSet(pyramid.coverage(9)));
+        assertEquals(new HashSet<>(Arrays.asList(parent, h3.h3ToParent(other, 8))), toSet(pyramid.coverage(8)));
+        assertEquals(new HashSet<>(Arrays.asList(parent, h3.h3ToParent(other, 7))), toSet(pyramid.coverage(7)));
+        assertEquals(toSet(pyramid.level(6)), toSet(pyramid.coverage(6)));
+
+        CellPyramid mean = h3.buildPyramid(cells, values, 7, Aggregation.mean);
+        assertEquals(24, mean.values[mean.indexOf(7, parent)], EPSILON);
+        CellPyramid max = h3.buildPyramid(cells, values, 7, Aggregation.max);
+        assertEquals(48, max.values[max.indexOf(7, parent)], EPSILON);
+    }
+
+    @Test
+    public void testBuildPyramidDuplicatesAndEmpty() {
+        long cell = h3.geoToH3(37.775, -122.418, 9);
+        CellPyramid pyramid = h3.buildPyramid(new long[] {cell, cell}, new double[] {1, 2}, 9, Aggregation.min);
+        assertEquals(1, pyramid.levelSize(9));
+        assertEquals(1, pyramid.values[0], EPSILON);
+        assertEquals(2, pyramid.counts[0]);
+
+        CellPyramid empty = h3.buildPyramid(new long[0], new double[0], 5, Aggregation.sum);
+        assertEquals(0, empty.levelSize(5));
+        assertEquals(0, empty.coverage(5).length);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testBuildPyramidMinResTooFine() {
+        h3.buildPyramid(new long[] {h3.geoToH3(0, 0, 5)}, new double[] {1}, 6, Aggregation.sum);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testBuildPyramidMismatchedLengths() {
+        h3.buildPyramid(new long[] {h3.geoToH3(0, 0, 5)}, new double[0], 4, Aggregation.sum);
+    }
+
+    private static Set<Long> toSet(long[] cells) {
+        Set<Long> set = new HashSet<>();
+        for (long cell : cells) {
+            set.add(cell);
+        }
+        return set;
+    }
 }
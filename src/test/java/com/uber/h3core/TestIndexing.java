@@ -15,19 +15,28 @@
  */
 package com.uber.h3core;
 
+import com.uber.h3core.util.CellMesh;
 import com.uber.h3core.util.GeoCoord;
 import org.junit.Test;
 
 import java.util.ArrayList;
 import java.util.List;
+import java.util.Random;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertTrue;
 
 /**
  * Tests for indexing functions (geoToH3, h3ToGeo, h3ToGeoBoundary)
  */
 public class TestIndexing extends BaseTestH3Core {
+    /**
+     * Width of the band inside cell edges where geoToH3Approx uses exact indexing, in radians.
+     */
+    private static final double APPROX_EDGE_BAND = 1e-10;
+
     @Test
     public void testGeoToH3() {
         assertEquals(h3.geoToH3(67.194013596, 191.598258018, 5), 22758474429497343L | (1L << 59L));
@@ -113,4 +122,324 @@ public class TestIndexing extends BaseTestH3Core {
             // Acceptable result
         }
     }
+
+    @Test
+    public void testGeoToH3Batch() {
+        double[] latLngs = {67.194013596, 191.598258018, 37.775938728915946, -122.41795063018799, -10, 10};
+
+        long[] cells = h3.geoToH3(latLngs, 5);
+
+        assertEquals(3, cells.length);
+        for (int i = 0; i < cells.length; i++) {
+            assertEquals(h3.geoToH3(latLngs[i * 2], latLngs[i * 2 + 1], 5), cells[i]);
+        }
+        assertEquals(0, h3.geoToH3(new double[0], 5).length);
+    }
+
+    @Test
+    public void testGeoToH3Approx() {
+        Random random = new Random(0xc0ffee);
+        for (int res = 0; res <= 9; res++) {
+            // Clustered around a few centers, as the approximation is intended for.
+            double[] latLngs = new double[20000];
+            for (int i = 0; i < latLngs.length; i += 2) {
+                int center = random.nextInt(4);
+                latLngs[i] = -60 + center * 40 + random.nextGaussian();
+                latLngs[i + 1] = -170 + center * 100 + random.nextGaussian();
+            }
+
+            long[] exact = h3.geoToH3(latLngs, res);
+            long[] approx = h3.geoToH3Approx(latLngs, res);
+
+            int mismatches = 0;
+            for (int i = 0; i < exact.length; i++) {
+                if (exact[i] != approx[i]) {
+                    mismatches++;
+                    List<GeoCoord> boundary = h3.h3ToGeoBoundary(exact[i]);
+                    // Cells with distortion vertices or crossing a face edge are excepted
+                    if (boundary.size() == 6 && h3.h3GetFaces(exact[i]).size() == 1) {
+                        double distance = distanceToBoundary(boundary, latLngs[i * 2], latLngs[i * 2 + 1]);
+                        assertTrue("mismatch " + distance + " from an edge at res " + res,
+                                distance <= APPROX_EDGE_BAND);
+                    }
+                }
+            }
+            assertTrue("mismatches at res " + res + ": " + mismatches, mismatches <= exact.length / 10000);
+        }
+    }
+
+    @Test
+    public void testGeoToH3ApproxMatchesAtCenters() {
+        List<Long> cells = h3.kRing(h3.geoToH3(37.775938728915946, -122.41795063018799, 7), 3);
+        double[] latLngs = new double[cells.size() * 2];
+        for (int i = 0; i < cells.size(); i++) {
+            GeoCoord center = h3.h3ToGeo(cells.get(i));
+            latLngs[i * 2] = center.lat;
+            latLngs[i * 2 + 1] = center.lng;
+        }
+
+        long[] approx = h3.geoToH3Approx(latLngs, 7);
+
+        assertArrayEquals(cells.stream().mapToLong(Long::longValue).toArray(), approx);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testGeoToH3BatchOddLength() {
+        h3.geoToH3(new double[] {0, 0, 0}, 5);
+    }
+
+    @Test
+    public void testGeoToH3BatchThreads() {
+        Random random = new Random(0);
+        double[] latLngs = new double[20000 * 2];
+        for (int i = 0; i < latLngs.length; i += 2) {
+            latLngs[i] = random.nextDouble() * 180 - 90;
+            latLngs[i + 1] = random.nextDouble() * 360 - 180;
+        }
+
+        assertArrayEquals(h3.geoToH3(latLngs, 7, 1), h3.geoToH3(latLngs, 7, 4));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testGeoToH3BatchNoThreads() {
+        h3.geoToH3(new double[] {0, 0}, 5, 0);
+    }
+
+    @Test
+    public void testH3ToGeoBatch() {
+        long[] cells = {h3.geoToH3(37.775, -122.418, 9), 0, 0x821c07fffffffffL};
+
+        double[] centers = h3.h3ToGeo(cells);
+
+        assertEquals(cells.length * 2, centers.length);
+        for (int i : new int[] {0, 2}) {
+            GeoCoord center = h3.h3ToGeo(cells[i]);
+            assertEquals(center.lat, centers[i * 2], EPSILON);
+            assertEquals(center.lng, centers[i * 2 + 1], EPSILON);
+        }
+        assertTrue(Double.isNaN(centers[2]));
+    }
+
+    @Test
+    public void testH3ToGeoBoundaryBatch() {
+        List<Long> disk = h3.kRing(h3.geoToH3(37.775, -122.418, 7), 40);
+        disk.add(0L);
+        disk.add(0x821c07fffffffffL);
+        long[] cells = disk.stream().mapToLong(Long::longValue).toArray();
+        int[] offsets = new int[cells.length + 1];
+
+        double[] verts = h3.h3ToGeoBoundary(cells, offsets, 4);
+
+        assertEquals(offsets[cells.length] * 2, verts.length);
+        for (int i = 0; i < cells.length; i++) {
+            List<GeoCoord> expected = cells[i] == 0 ? new ArrayList<>() : h3.h3ToGeoBoundary(cells[i]);
+            assertEquals(expected.size(), offsets[i + 1] - offsets[i]);
+            for (int v = 0; v < expected.size(); v++) {
+                assertEquals(expected.get(v).lat, verts[(offsets[i] + v) * 2], EPSILON);
+                assertEquals(expected.get(v).lng, verts[(offsets[i] + v) * 2 + 1], EPSILON);
+            }
+        }
+        int[] singleThreadOffsets = new int[cells.length + 1];
+        assertArrayEquals(verts, h3.h3ToGeoBoundary(cells, singleThreadOffsets, 1), 0);
+        assertArrayEquals(offsets, singleThreadOffsets);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testGeoToH3ApproxNaN() {
+        h3.geoToH3Approx(new double[] {0, 0, Double.NaN, Double.NaN}, 5);
+    }
+
+    @Test
+    public void testCellsToMesh() {
+        long[] disk = h3.kRing(h3.geoToH3(37.775, -122.418, 9), 2).stream().mapToLong(Long::longValue).toArray();
+        CellMesh mesh = h3.cellsToMesh(disk);
+
+        assertEquals(disk.length, mesh.numCells());
+        // A disk of radius k has 6 (k + 1)^2 distinct vertices
+        assertEquals(6 * 3 * 3, mesh.numVertices());
+        for (int c = 0; c < disk.length; c++) {
+            List<GeoCoord> boundary = h3.h3ToGeoBoundary(disk[c]);
+            assertEquals(boundary.size(), mesh.offsets[c + 1] - mesh.offsets[c]);
+            for (int i = 0; i < boundary.size(); i++) {
+                int v = mesh.indices[mesh.offsets[c] + i];
+                assertEquals(boundary.get(i).lat, mesh.vertices[2 * v], EPSILON);
+                assertEquals(boundary.get(i).lng, mesh.vertices[2 * v + 1], EPSILON);
+            }
+        }
+
+        assertEquals(disk.length * 4 * 3, mesh.triangles().length);
+    }
+
+    @Test
+    public void testCellsToMeshInvalid() {
+        CellMesh mesh = h3.cellsToMesh(new long[] {0, 0x7fffffffffffffffL, h3.geoToH3(0, 0, 5)});
+
+        assertEquals(3, mesh.numCells());
+        assertEquals(0, mesh.offsets[1]);
+        assertEquals(0, mesh.offsets[2]);
+        assertEquals(6, mesh.numVertices());
+    }
+
+    @Test
+    public void testCellBBox() {
+        long[] cells = h3.kRing(h3.geoToH3(37.775, -122.418, 9), 1).stream().mapToLong(Long::longValue).toArray();
+        double[] boxes = new double[cells.length * 4];
+        h3.cellBBox(cells, boxes);
+
+        for (int c = 0; c < cells.length; c++) {
+            double south = Double.MAX_VALUE;
+            double west = Double.MAX_VALUE;
+            double north = -Double.MAX_VALUE;
+            double east = -Double.MAX_VALUE;
+            for (GeoCoord coord : h3.h3ToGeoBoundary(cells[c])) {
+                south = Math.min(south, coord.lat);
+                west = Math.min(west, coord.lng);
+                north = Math.max(north, coord.lat);
+                east = Math.max(east, coord.lng);
+            }
+            // Edges bulge past the vertices by much less than this at this resolution
+            assertEquals(south, boxes[c * 4], 1e-6);
+            assertEquals(west, boxes[c * 4 + 1], EPSILON);
+            assertEquals(north, boxes[c * 4 + 2], 1e-6);
+            assertEquals(east, boxes[c * 4 + 3], EPSILON);
+            assertTrue(boxes[c * 4] <= south && boxes[c * 4 + 2] >= north);
+        }
+    }
+
+    @Test
+    public void testCellBBoxAntimeridianAndPole() {
+        double[] boxes = new double[3 * 4];
+        h3.cellBBox(new long[] {h3.geoToH3(0, 180, 5), h3.geoToH3(90, 0, 2), 0}, boxes);
+
+        assertTrue("Crosses the antimeridian", boxes[1] > boxes[3]);
+        assertTrue(boxes[1] > 179 && boxes[3] < -179);
+        assertEquals(90, boxes[4 + 2], EPSILON);
+        assertEquals(-180, boxes[4 + 1], EPSILON);
+        assertEquals(180, boxes[4 + 3], EPSILON);
+        assertTrue("Invalid index", Double.isNaN(boxes[8]));
+    }
+
+    @Test
+    public void testCellParentBBox() {
+        long[] cells = {h3.geoToH3(37.775, -122.418, 9), h3.geoToH3(37.776, -122.418, 9), h3.geoToH3(-33.9, 18.4, 9)};
+        for (int parentRes : new int[] {0, 5}) {
+            long[] parents = new long[cells.length];
+            for (int i = 0; i < cells.length; i++) {
+                parents[i] = h3.h3ToParent(cells[i], parentRes);
+            }
+            double[] expected = new double[cells.length * 4];
+            h3.cellBBox(parents, expected);
+            double[] boxes = new double[cells.length * 4];
+            h3.cellParentBBox(cells, parentRes, boxes);
+            assertArrayEquals(expected, boxes, EPSILON);
+        }
+    }
+
+    @Test
+    public void testCellParentBBoxInvalid() {
+        long cell = h3.geoToH3(37.775, -122.418, 9);
+        // Same resolution, but base cell 127 does not exist
+        long[] cells = {0, cell | (0x7fL << 45), h3.h3ToParent(cell, 3)};
+        for (int parentRes : new int[] {0, 5}) {
+            double[] boxes = new double[cells.length * 4];
+            h3.cellParentBBox(cells, parentRes, boxes);
+            for (int i = 0; i < cells.length; i++) {
+                if (parentRes == 0 && i == 2) {
+                    assertTrue("Index is finer than its parent", boxes[i * 4] < boxes[i * 4 + 2]);
+                } else {
+                    assertTrue("Parent " + i + " at res " + parentRes + " is invalid", Double.isNaN(boxes[i * 4]));
+                }
+            }
+        }
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testCellBBoxShortOutput() {
+        h3.cellBBox(new long[] {h3.geoToH3(0, 0, 5)}, new double[3]);
+    }
+
+    @Test
+    public void testCellCentersToPlanar() {
+        GeoCoord origin = new GeoCoord(37.775, -122.418);
+        long center = h3.geoToH3(origin.lat, origin.lng, 9);
+        long[] cells = h3.kRing(center, 10).stream().mapToLong(Long::longValue).toArray();
+
+        double[] enu = h3.cellCentersToPlanar(cells, origin.lat, origin.lng, PlanarProjection.enu);
+        double[] aeqd = h3.cellCentersToPlanar(cells, origin.lat, origin.lng, PlanarProjection.azimuthalEquidistant);
+        float[] aeqdFloat = h3.cellCentersToPlanarFloat(cells, origin.lat, origin.lng,
+                PlanarProjection.azimuthalEquidistant);
+        assertEquals(cells.length * 2, aeqd.length);
+        for (int i = 0; i < cells.length; i++) {
+            GeoCoord cellCenter = h3.h3ToGeo(cells[i]);
+            double distance = h3.pointDist(origin, cellCenter, LengthUnit.m);
+            assertEquals("Distance from the origin is exact", distance, Math.hypot(aeqd[i * 2], aeqd[i * 2 + 1]), 1e-4);
+            assertEquals("Close to the origin, the projections agree", aeqd[i * 2], enu[i * 2], 0.1);
+            assertEquals(aeqd[i * 2 + 1], enu[i * 2 + 1], 0.1);
+            assertEquals(aeqd[i * 2], aeqdFloat[i * 2], 1e-3);
+            // East and north of the origin have positive x and y
+            assertEquals(Math.signum(cellCenter.lng - origin.lng), Math.signum(aeqd[i * 2]), 0);
+        }
+    }
+
+    @Test
+    public void testCellBoundariesToPlanar() {
+        long[] cells = {h3.geoToH3(37.775, -122.418, 9), 0, h3.geoToH3(37.78, -122.41, 9)};
+        int[] offsets = new int[cells.length + 1];
+        double[] verts = h3.cellBoundariesToPlanar(cells, 37.775, -122.418, PlanarProjection.enu, offsets);
+        int[] floatOffsets = new int[cells.length + 1];
+        float[] floatVerts = h3.cellBoundariesToPlanarFloat(cells, 37.775, -122.418, PlanarProjection.enu,
+                floatOffsets);
+
+        assertArrayEquals(new int[] {0, 6, 6, 12}, offsets);
+        assertArrayEquals(offsets, floatOffsets);
+        assertEquals(12 * 2, verts.length);
+        assertEquals(verts.length, floatVerts.length);
+        double[] centers = h3.cellCentersToPlanar(cells, 37.775, -122.418, PlanarProjection.enu);
+        for (int v = 0; v < 6; v++) {
+            double dx = verts[v * 2] - centers[0];
+            double dy = verts[v * 2 + 1] - centers[1];
+            // Resolution 9 edges are about 174 meters long
+            assertTrue(Math.hypot(dx, dy) > 100 && Math.hypot(dx, dy) < 250);
+        }
+        assertTrue(Double.isNaN(centers[2]));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testCellBoundariesToPlanarShortOffsets() {
+        h3.cellBoundariesToPlanar(new long[] {h3.geoToH3(0, 0, 5)}, 0, 0, PlanarProjection.enu, new int[1]);
+    }
+
+    /**
+     * Radians from the great circles through the edges of the cell boundary to the point,
+     * to the nearest one.
+     */
+    private static double distanceToBoundary(List<GeoCoord> boundary, double lat, double lng) {
+        double[] point = toUnitVector(lat, lng);
+        double distance = Double.POSITIVE_INFINITY;
+        for (int i = 0; i < boundary.size(); i++) {
+            GeoCoord a = boundary.get(i);
+            GeoCoord b = boundary.get((i + 1) % boundary.size());
+            double[] u = toUnitVector(a.lat, a.lng);
+            double[] v = toUnitVector(b.lat, b.lng);
+            double[] normal = {
+                u[1] * v[2] - u[2] * v[1],
+                u[2] * v[0] - u[0] * v[2],
+                u[0] * v[1] - u[1] * v[0]
+            };
+            double length = Math.sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            double dot = (normal[0] * point[0] + normal[1] * point[1] + normal[2] * point[2]) / length;
+            distance = Math.min(distance, Math.abs(Math.asin(dot)));
+        }
+        return distance;
+    }
+
+    private static double[] toUnitVector(double lat, double lng) {
+        double latRads = Math.toRadians(lat);
+        double lngRads = Math.toRadians(lng);
+        return new double[] {
+            Math.cos(latRads) * Math.cos(lngRads),
+            Math.cos(latRads) * Math.sin(lngRads),
+            Math.sin(latRads)
+        };
+    }
 }
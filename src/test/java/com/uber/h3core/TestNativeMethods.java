@@ -21,7 +21,9 @@ import org.junit.Test;
 
 import java.io.IOException;
 import java.util.ArrayList;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
 import java.util.concurrent.atomic.AtomicInteger;
 
 import static org.junit.Assert.assertEquals;
@@ -68,4 +70,54 @@ public class TestNativeMethods {
     public void getPentagonIndexes() {
         nativeMethods.getPentagonIndexes(1, new long[1]);
     }
+
+    /**
+     * Test that the prepared polyfill finds exactly the cells the core library's polyfill finds,
+     * including for cells on edges and vertices of the polygon.
+     */
+    @Test
+    public void testPolyfillPreparedMatchesCore() {
+        double[] verts = wigglyLoop(0.66, -2.14, 0.002, 2000);
+        int[] holeSizes = new int[] {400, 400};
+        double[] holeVerts = new double[800];
+        System.arraycopy(wigglyLoop(0.6605, -2.14, 0.0003, 200), 0, holeVerts, 0, 400);
+        System.arraycopy(wigglyLoop(0.6595, -2.1395, 0.0003, 200), 0, holeVerts, 400, 400);
+
+        long polygon = nativeMethods.createPreparedPolygon(verts, holeSizes, holeVerts);
+        try {
+            for (int res = 5; res <= 10; res++) {
+                long[] core = new long[nativeMethods.maxPolyfillSize(verts, holeSizes, holeVerts, res)];
+                nativeMethods.polyfill(verts, holeSizes, holeVerts, res, core);
+                Set<Long> expected = new HashSet<>();
+                for (long cell : core) {
+                    if (cell != 0) {
+                        expected.add(cell);
+                    }
+                }
+
+                Set<Long> actual = new HashSet<>();
+                for (long cell : nativeMethods.polyfillPrepared(polygon, res)) {
+                    actual.add(cell);
+                }
+
+                assertEquals("res " + res, expected, actual);
+            }
+        } finally {
+            nativeMethods.destroyPreparedPolygon(polygon);
+        }
+    }
+
+    /**
+     * Interleaved lat/lng radians of a loop around the center, with many small lobes.
+     */
+    private static double[] wigglyLoop(double lat, double lng, double radius, int numVerts) {
+        double[] verts = new double[numVerts * 2];
+        for (int i = 0; i < numVerts; i++) {
+            double angle = 2 * Math.PI * i / numVerts;
+            double r = radius * (1 + 0.2 * Math.sin(angle * 37));
+            verts[i * 2] = lat + r * Math.sin(angle);
+            verts[i * 2 + 1] = lng + r * Math.cos(angle);
+        }
+        return verts;
+    }
 }
@@ -17,12 +17,20 @@ package com.uber.h3core;
 
 import com.google.common.collect.ImmutableList;
 import com.google.common.collect.ImmutableSet;
+import com.uber.h3core.exceptions.PentagonEncounteredException;
 import com.uber.h3core.util.GeoCoord;
+import com.uber.h3core.util.GroupedCells;
+import com.uber.h3core.util.TaskTiming;
 import org.junit.Test;
 
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
+import java.util.concurrent.ForkJoinPool;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertTrue;
@@ -248,6 +256,127 @@ public class TestRegion extends BaseTestH3Core {
         assertEquals(6, multiBounds.get(0).get(1).size());
     }
 
+    @Test
+    public void testH3SetToMultiPolygonCompacted() {
+        List<Long> hexagons = h3.polyfill(
+                ImmutableList.of(
+                        new GeoCoord(37.813318999983238, -122.4089866999972145),
+                        new GeoCoord(37.7866302000007224, -122.3805436999997056),
+                        new GeoCoord(37.7198061999978478, -122.3544736999993603),
+                        new GeoCoord(37.7076131999975672, -122.5123436999983966),
+                        new GeoCoord(37.7835871999971715, -122.5247187000021967),
+                        new GeoCoord(37.8151571999998453, -122.4798767000009008)
+                ),
+                ImmutableList.<List<GeoCoord>>of(
+                        ImmutableList.<GeoCoord>of(
+                                new GeoCoord(37.7869802, -122.4471197),
+                                new GeoCoord(37.7664102, -122.4590777),
+                                new GeoCoord(37.7710682, -122.4137097)
+                        )
+                ),
+                9
+        );
+        List<Long> compacted = h3.compact(hexagons);
+        assertTrue("Input has mixed resolutions",
+                compacted.stream().mapToInt(h3::h3GetResolution).distinct().count() > 1);
+
+        assertSameOutline(h3.h3SetToMultiPolygon(hexagons, false), h3.h3SetToMultiPolygon(compacted, false));
+    }
+
+    @Test
+    public void testH3SetToMultiPolygonCompactedNonContiguous() throws PentagonEncounteredException {
+        long coarse = h3.geoToH3(37.775, -122.418, 6);
+        // A coarse cell, the children of a cell two steps away, and an isolated fine cell
+        List<Long> cells = new ArrayList<>();
+        cells.add(coarse);
+        cells.addAll(h3.h3ToChildren(h3.hexRing(coarse, 2).get(0), 7));
+        cells.add(h3.geoToH3(37.5, -122, 8));
+
+        List<Long> uncompacted = h3.uncompact(cells, 8);
+        assertSameOutline(h3.h3SetToMultiPolygon(uncompacted, false), h3.h3SetToMultiPolygon(cells, false));
+    }
+
+    @Test
+    public void testH3SetToMultiPolygonSimplified() {
+        List<Long> hexagons = h3.polyfill(
+                ImmutableList.of(
+                        new GeoCoord(37.813318999983238, -122.4089866999972145),
+                        new GeoCoord(37.7866302000007224, -122.3805436999997056),
+                        new GeoCoord(37.7198061999978478, -122.3544736999993603),
+                        new GeoCoord(37.7076131999975672, -122.5123436999983966),
+                        new GeoCoord(37.7835871999971715, -122.5247187000021967),
+                        new GeoCoord(37.8151571999998453, -122.4798767000009008)
+                ), null, 9
+        );
+
+        List<List<List<GeoCoord>>> original = h3.h3SetToMultiPolygon(hexagons, false);
+        List<List<List<GeoCoord>>> simplified = h3.h3SetToMultiPolygon(hexagons, false, 200);
+
+        assertEquals(original.size(), simplified.size());
+        Set<String> originalVertices = new HashSet<>();
+        int numOriginal = 0;
+        for (List<List<GeoCoord>> polygon : original) {
+            for (List<GeoCoord> loop : polygon) {
+                numOriginal += loop.size();
+                for (GeoCoord coord : loop) {
+                    originalVertices.add(String.format("%.9f,%.9f", coord.lat, coord.lng));
+                }
+            }
+        }
+        int numSimplified = 0;
+        for (List<List<GeoCoord>> polygon : simplified) {
+            for (List<GeoCoord> loop : polygon) {
+                assertTrue("Loop is not degenerate", loop.size() >= 3);
+                numSimplified += loop.size();
+                for (GeoCoord coord : loop) {
+                    assertTrue("Vertices are kept from the original",
+                            originalVertices.contains(String.format("%.9f,%.9f", coord.lat, coord.lng)));
+                }
+            }
+        }
+        assertTrue("Simplification removes most vertices", numSimplified * 10 < numOriginal);
+    }
+
+    @Test
+    public void testH3SetToMultiPolygonSimplifiedZeroTolerance() {
+        long origin = h3.geoToH3(37.775, -122.418, 9);
+        // Hexagon boundaries have no vertices in a straight line
+        assertSameOutline(h3.h3SetToMultiPolygon(h3.kRing(origin, 3), true),
+                h3.h3SetToMultiPolygon(h3.kRing(origin, 3), true, 0));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testH3SetToMultiPolygonSimplifiedNegativeTolerance() {
+        h3.h3SetToMultiPolygon(ImmutableList.of(h3.geoToH3(0, 0, 5)), false, -1);
+    }
+
+    /**
+     * Asserts the polygons have the same loops, which may start at different vertices and
+     * be in a different order.
+     */
+    private static void assertSameOutline(List<List<List<GeoCoord>>> expected, List<List<List<GeoCoord>>> actual) {
+        assertEquals("Same number of polygons", expected.size(), actual.size());
+        assertEquals(loopKeys(expected), loopKeys(actual));
+    }
+
+    /**
+     * For each loop, the polygon size and the loop's set of vertices, rounded.
+     */
+    private static Set<Set<String>> loopKeys(List<List<List<GeoCoord>>> polygons) {
+        Set<Set<String>> keys = new HashSet<>();
+        for (List<List<GeoCoord>> polygon : polygons) {
+            for (int i = 0; i < polygon.size(); i++) {
+                Set<String> key = new HashSet<>();
+                key.add((i == 0 ? "outer " : "hole ") + polygon.size());
+                for (GeoCoord coord : polygon.get(i)) {
+                    key.add(String.format("%.9f,%.9f", coord.lat, coord.lng));
+                }
+                keys.add(key);
+            }
+        }
+        return keys;
+    }
+
     @Test
     public void testH3SetToMultiPolygonLarge() {
         int numHexes = 20000;
@@ -265,4 +394,289 @@ public class TestRegion extends BaseTestH3Core {
             assertEquals(6, multiBounds.get(i).get(0).size());
         }
     }
+
+    @Test
+    public void testPreparedPolygon() {
+        List<GeoCoord> outline = ImmutableList.of(
+                new GeoCoord(37.813318999983238, -122.4089866999972145),
+                new GeoCoord(37.7866302000007224, -122.3805436999997056),
+                new GeoCoord(37.7198061999978478, -122.3544736999993603),
+                new GeoCoord(37.7076131999975672, -122.5123436999983966),
+                new GeoCoord(37.7835871999971715, -122.5247187000021967),
+                new GeoCoord(37.8151571999998453, -122.4798767000009008)
+        );
+        List<List<GeoCoord>> holes = ImmutableList.of(
+                ImmutableList.of(
+                        new GeoCoord(37.7869802, -122.4471197),
+                        new GeoCoord(37.7664102, -122.4590777),
+                        new GeoCoord(37.7710682, -122.4137097)
+                )
+        );
+
+        try (PreparedGeoPolygon prepared = h3.preparePolygon(outline, holes)) {
+            assertTrue(prepared.contains(37.76, -122.45));
+            assertFalse(prepared.contains(37.775, -122.44));
+            assertFalse(prepared.contains(37.76, -122.2));
+
+            for (int res = 0; res <= 9; res++) {
+                List<Long> preparedCells = prepared.polyfill(res);
+                assertEquals(new HashSet<>(h3.polyfill(outline, holes, res)), new HashSet<>(preparedCells));
+                assertEquals(new HashSet<>(preparedCells).size(), preparedCells.size());
+            }
+        }
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testPreparedPolygonClosed() {
+        PreparedGeoPolygon prepared = h3.preparePolygon(ImmutableList.of(
+                new GeoCoord(0, 0), new GeoCoord(0, 1), new GeoCoord(1, 1)
+        ), null);
+        prepared.close();
+        // Closing twice has no effect
+        prepared.close();
+        prepared.polyfill(5);
+    }
+
+    @Test
+    public void testPolyfillManyVertices() {
+        GeoCoord center = new GeoCoord(37.775, -122.418);
+        int res = 8;
+        List<GeoCoord> outline = new ArrayList<>();
+        for (int i = 0; i < 5000; i++) {
+            double angle = 2 * Math.PI * i / 5000;
+            double radius = 0.1 + 0.02 * Math.sin(angle * 50);
+            outline.add(new GeoCoord(center.lat + radius * Math.sin(angle), center.lng + radius * Math.cos(angle)));
+        }
+
+        Set<Long> cells = new HashSet<>(h3.polyfill(outline, null, res));
+
+        // Every cell near the polygon whose center is inside must be found, and no others.
+        Set<Long> expected = new HashSet<>();
+        try (PreparedGeoPolygon prepared = h3.preparePolygon(outline, null)) {
+            for (long cell : h3.kRing(h3.geoToH3(center.lat, center.lng, res), 40)) {
+                GeoCoord cellCenter = h3.h3ToGeo(cell);
+                if (prepared.contains(cellCenter.lat, cellCenter.lng)) {
+                    expected.add(cell);
+                }
+            }
+        }
+        assertTrue(expected.size() > 1000);
+        assertEquals(expected, cells);
+    }
+
+    @Test
+    public void testPolyfillBatch() {
+        // Many small squares, with a hole in every third one
+        int numPolygons = 500;
+        int res = 11;
+        List<List<GeoCoord>> outlines = new ArrayList<>();
+        List<List<GeoCoord>> holes = new ArrayList<>();
+        double[] verts = new double[numPolygons * 16];
+        int[] ringOffsets = new int[numPolygons * 2 + 1];
+        int[] polygonOffsets = new int[numPolygons + 1];
+        int vert = 0;
+        int ring = 0;
+        for (int i = 0; i < numPolygons; i++) {
+            double lat = 37.7 + (i / 25) * 0.01;
+            double lng = -122.5 + (i % 25) * 0.01;
+            List<GeoCoord> outline = ImmutableList.of(
+                    new GeoCoord(lat, lng), new GeoCoord(lat, lng + 0.008),
+                    new GeoCoord(lat + 0.008, lng + 0.008), new GeoCoord(lat + 0.008, lng));
+            List<GeoCoord> hole = ImmutableList.of(
+                    new GeoCoord(lat + 0.002, lng + 0.002), new GeoCoord(lat + 0.006, lng + 0.002),
+                    new GeoCoord(lat + 0.006, lng + 0.006), new GeoCoord(lat + 0.002, lng + 0.006));
+            outlines.add(outline);
+            holes.add(i % 3 == 0 ? hole : null);
+
+            polygonOffsets[i] = ring;
+            for (List<GeoCoord> loop : i % 3 == 0 ? ImmutableList.of(outline, hole) : ImmutableList.of(outline)) {
+                ringOffsets[ring++] = vert;
+                for (GeoCoord coord : loop) {
+                    verts[vert * 2] = coord.lat;
+                    verts[vert * 2 + 1] = coord.lng;
+                    vert++;
+                }
+            }
+        }
+        ringOffsets[ring] = vert;
+        polygonOffsets[numPolygons] = ring;
+        verts = Arrays.copyOf(verts, vert * 2);
+        ringOffsets = Arrays.copyOf(ringOffsets, ring + 1);
+
+        GroupedCells grouped = h3.polyfillBatch(verts, ringOffsets, polygonOffsets, res);
+
+        assertEquals(numPolygons, grouped.numGroups());
+        for (int i = 0; i < numPolygons; i++) {
+            List<GeoCoord> hole = holes.get(i);
+            Set<Long> expected = new HashSet<>(h3.polyfill(outlines.get(i),
+                    hole == null ? null : ImmutableList.of(hole), res));
+            Set<Long> actual = new HashSet<>();
+            for (long cell : grouped.group(i)) {
+                actual.add(cell);
+            }
+            assertEquals("polygon " + i, expected, actual);
+            assertEquals(expected.size(), grouped.groupSize(i));
+        }
+
+        // The result does not depend on the number of threads
+        assertEquals(grouped, h3.polyfillBatch(verts, ringOffsets, polygonOffsets, res, 1));
+    }
+
+    @Test
+    public void testPolyfillBatchEmpty() {
+        GroupedCells grouped = h3.polyfillBatch(new double[0], new int[] {0}, new int[] {0, 0, 0}, 9);
+
+        assertEquals(2, grouped.numGroups());
+        assertEquals(0, grouped.cells.length);
+        assertEquals(0, grouped.groupSize(1));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testPolyfillBatchInvalidOffsets() {
+        h3.polyfillBatch(new double[] {0, 0, 0, 1, 1, 1}, new int[] {0, 4}, new int[] {0, 1}, 9);
+    }
+
+    @Test
+    public void testPolyfillExecutor() {
+        // A large notched polygon with a hole, which is split into tiles, and a small one
+        double[] verts = {
+                37.5, -122.6, 37.9, -122.6, 37.9, -122.2, 37.7, -122.4, 37.5, -122.2,
+                37.75, -122.55, 37.8, -122.55, 37.8, -122.5,
+                37.77, -122.41, 37.775, -122.41, 37.775, -122.405
+        };
+        int[] ringOffsets = {0, 5, 8, 11};
+        int[] polygonOffsets = {0, 2, 3};
+        int res = 10;
+        ForkJoinPool pool = new ForkJoinPool(4);
+        try {
+            PolyfillExecutor executor = h3.newPolyfillExecutor(pool);
+            List<TaskTiming> timings = new ArrayList<>();
+            GroupedCells grouped = executor.polyfill(verts, ringOffsets, polygonOffsets, res, false, timings);
+
+            GroupedCells expected = h3.polyfillBatch(verts, ringOffsets, polygonOffsets, res);
+            for (int i = 0; i < 2; i++) {
+                long[] expectedCells = expected.group(i);
+                Arrays.sort(expectedCells);
+                assertArrayEquals("polygon " + i, expectedCells, grouped.group(i));
+            }
+            assertTrue("Large polygon is split", timings.stream().filter(t -> t.input == 0).count() > 1);
+            assertEquals(1, timings.stream().filter(t -> t.input == 1).count());
+            assertEquals(grouped.cells.length, timings.stream().mapToInt(t -> t.numCells).sum());
+
+            GroupedCells compacted = executor.polyfill(verts, ringOffsets, polygonOffsets, res, true, null);
+            for (int i = 0; i < 2; i++) {
+                List<Long> cells = new ArrayList<>();
+                for (long cell : grouped.group(i)) {
+                    cells.add(cell);
+                }
+                long[] expectedCells = h3.compact(cells).stream().mapToLong(Long::longValue).toArray();
+                Arrays.sort(expectedCells);
+                assertArrayEquals("compacted polygon " + i, expectedCells, compacted.group(i));
+            }
+        } finally {
+            pool.shutdown();
+        }
+    }
+
+    @Test
+    public void testPolyfillExecutorEdgeAlongTile() {
+        // Polygons with an edge just either side of, and along, an edge of a tile
+        int res = 10;
+        long tile = h3.geoToH3(37.775, -122.418, res - 3);
+        List<GeoCoord> boundary = h3.h3ToGeoBoundary(tile);
+        GeoCoord from = boundary.get(0);
+        GeoCoord to = boundary.get(1);
+        double dLat = to.lat - from.lat;
+        double dLng = to.lng - from.lng;
+        ForkJoinPool pool = new ForkJoinPool(4);
+        try {
+            PolyfillExecutor executor = h3.newPolyfillExecutor(pool);
+            for (double offset : new double[] {-1e-4, -1e-6, 0, 1e-6, 1e-4}) {
+                double lat0 = from.lat - 15 * dLat - offset * dLng;
+                double lng0 = from.lng - 15 * dLng + offset * dLat;
+                double lat1 = to.lat + 15 * dLat - offset * dLng;
+                double lng1 = to.lng + 15 * dLng + offset * dLat;
+                double[] verts = {
+                        lat0, lng0, lat1, lng1, lat1 + 30 * dLng, lng1 - 30 * dLat, lat0 + 30 * dLng, lng0 - 30 * dLat
+                };
+                int[] ringOffsets = {0, 4};
+                int[] polygonOffsets = {0, 1};
+
+                List<TaskTiming> timings = new ArrayList<>();
+                GroupedCells grouped = executor.polyfill(verts, ringOffsets, polygonOffsets, res, false, timings);
+                assertTrue("Polygon is split", timings.size() > 1);
+                long[] expected = h3.polyfillBatch(verts, ringOffsets, polygonOffsets, res).group(0);
+                Arrays.sort(expected);
+                assertArrayEquals("offset " + offset, expected, grouped.group(0));
+            }
+        } finally {
+            pool.shutdown();
+        }
+    }
+
+    @Test
+    public void testPolyfillBBox() {
+        double south = 37.7;
+        double west = -122.5;
+        double north = 37.8;
+        double east = -122.4;
+
+        Set<Long> cells = new HashSet<>(h3.polyfillBBox(south, west, north, east, 9));
+        Set<Long> polygonCells = new HashSet<>(h3.polyfill(ImmutableList.of(
+                new GeoCoord(south, west), new GeoCoord(south, east),
+                new GeoCoord(north, east), new GeoCoord(north, west)
+        ), null, 9));
+
+        assertTrue(cells.size() > 1000);
+        assertEquals(polygonCells, cells);
+    }
+
+    @Test
+    public void testPolyfillBBoxTransmeridian() {
+        int res = 6;
+        Set<Long> cells = new HashSet<>(h3.polyfillBBox(-1, 179, 1, -179, res));
+
+        Set<Long> expected = new HashSet<>();
+        for (long cell : h3.kRing(h3.geoToH3(0, 180, res), 30)) {
+            GeoCoord center = h3.h3ToGeo(cell);
+            if (center.lat >= -1 && center.lat <= 1 && Math.abs(center.lng) >= 179) {
+                expected.add(cell);
+            }
+        }
+        assertTrue(expected.size() > 50);
+        assertEquals(expected, cells);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testPolyfillBBoxInvalid() {
+        h3.polyfillBBox(10, 0, 5, 1, 5);
+    }
+
+    @Test
+    public void testPolyfillCircle() {
+        GeoCoord center = new GeoCoord(37.775, -122.418);
+        double radiusMeters = 5000;
+        int res = 9;
+
+        Set<Long> cells = new HashSet<>(h3.polyfillCircle(center.lat, center.lng, radiusMeters, res));
+
+        Set<Long> expected = new HashSet<>();
+        for (long cell : h3.kRing(h3.geoToH3(center.lat, center.lng, res), 40)) {
+            if (h3.pointDist(center, h3.h3ToGeo(cell), LengthUnit.m) <= radiusMeters) {
+                expected.add(cell);
+            }
+        }
+        assertTrue(expected.size() > 100);
+        assertEquals(expected, cells);
+    }
+
+    @Test
+    public void testPolyfillCircleSmall() {
+        // Smaller than a cell, so at most the cell containing the center is found
+        List<Long> cells = h3.polyfillCircle(37.775, -122.418, 1, 5);
+        assertTrue(cells.size() <= 1);
+
+        // Much larger than a cell, so the cell containing the center is found
+        assertTrue(h3.polyfillCircle(37.775, -122.418, 100, 15).contains(h3.geoToH3(37.775, -122.418, 15)));
+    }
 }
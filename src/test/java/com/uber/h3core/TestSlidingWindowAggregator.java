@@ -0,0 +1,106 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core;
+
+import org.junit.Test;
+
+import java.util.List;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests for {@link SlidingWindowAggregator}.
+ */
+public class TestSlidingWindowAggregator extends BaseTestH3Core {
+    private static final long MINUTE = 60_000;
+
+    @Test
+    public void testWindow() {
+        // Five minutes, in one minute buckets
+        SlidingWindowAggregator aggregator = h3.newSlidingWindowAggregator(9, MINUTE, 5);
+        long cell = h3.geoToH3(37.775, -122.418, 9);
+        assertEquals(5 * MINUTE, aggregator.getWindowMillis());
+
+        aggregator.add(37.775, -122.418, 0, 1.5);
+        aggregator.add(cell, 2 * MINUTE, 2);
+        aggregator.add(cell, 4 * MINUTE + 1, 3);
+
+        assertEquals(3, aggregator.count(cell, 4 * MINUTE + 1));
+        assertEquals(6.5, aggregator.sum(cell, 4 * MINUTE + 1), EPSILON);
+        // The first bucket has left the window
+        assertEquals(2, aggregator.count(cell, 5 * MINUTE));
+        assertEquals(5, aggregator.sum(cell, 5 * MINUTE), EPSILON);
+        assertEquals(0, aggregator.count(cell, 9 * MINUTE));
+        // Only events up to the given time are counted
+        assertEquals(1, aggregator.count(cell, MINUTE));
+
+        // The first bucket is reused
+        aggregator.add(cell, 5 * MINUTE, 10);
+        assertEquals(3, aggregator.count(cell, 5 * MINUTE));
+        // Too old to be counted
+        aggregator.add(cell, 0, 100);
+        assertEquals(15, aggregator.sum(cell, 5 * MINUTE), EPSILON);
+    }
+
+    @Test
+    public void testKRingAndParent() {
+        SlidingWindowAggregator aggregator = h3.newSlidingWindowAggregator(9, MINUTE, 5);
+        long cell = h3.geoToH3(37.775, -122.418, 9);
+        List<Long> disk = h3.kRing(cell, 2);
+        for (long neighbor : disk) {
+            aggregator.add(neighbor, 0, 2);
+        }
+
+        assertEquals(7, aggregator.countKRing(cell, 1, 0));
+        assertEquals(disk.size() * 2, aggregator.sumKRing(cell, 2, 0), EPSILON);
+
+        long parent = h3.h3ToParent(cell, 7);
+        long inParent = disk.stream().filter(c -> h3.h3ToParent(c, 7) == parent).count();
+        assertEquals(inParent, aggregator.count(parent, 0));
+        assertEquals(inParent * 2, aggregator.sum(parent, 0), EPSILON);
+
+        // Coarse parents have more descendants than the table has slots
+        for (int res : new int[] {0, 4}) {
+            long coarse = h3.h3ToParent(cell, res);
+            long inCoarse = disk.stream().filter(c -> h3.h3ToParent(c, res) == coarse).count();
+            assertEquals(inCoarse, aggregator.count(coarse, 0));
+            assertEquals(inCoarse * 2, aggregator.sum(coarse, 0), EPSILON);
+        }
+    }
+
+    @Test
+    public void testExpiredCellsDropped() {
+        SlidingWindowAggregator aggregator = h3.newSlidingWindowAggregator(9, MINUTE, 5);
+        List<Long> disk = h3.kRing(h3.geoToH3(37.775, -122.418, 9), 30);
+        for (long cell : disk.subList(0, 1000)) {
+            aggregator.add(cell, 0, 1);
+        }
+        for (long cell : disk.subList(1000, disk.size())) {
+            aggregator.add(cell, 10 * MINUTE, 1);
+        }
+
+        assertTrue(aggregator.size() < disk.size());
+        for (long cell : disk.subList(1000, disk.size())) {
+            assertEquals(1, aggregator.count(cell, 10 * MINUTE));
+        }
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testWrongResolution() {
+        h3.newSlidingWindowAggregator(9, MINUTE, 5).add(h3.geoToH3(0, 0, 8), 0, 1);
+    }
+}
@@ -19,11 +19,21 @@ import com.uber.h3core.exceptions.DistanceUndefinedException;
 import com.uber.h3core.exceptions.LineUndefinedException;
 import com.uber.h3core.exceptions.LocalIjUndefinedException;
 import com.uber.h3core.exceptions.PentagonEncounteredException;
+import com.uber.h3core.util.CellRuns;
 import com.uber.h3core.util.CoordIJ;
+import com.uber.h3core.util.GeoCoord;
+import com.uber.h3core.util.GroupedCells;
 import org.junit.Test;
 
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
+import java.util.stream.Collectors;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertTrue;
 
@@ -302,6 +312,19 @@ public class TestTraversal extends BaseTestH3Core {
         h3.h3Distance("821c37fffffffff", "822837fffffffff");
     }
 
+    @Test
+    public void testH3DistanceBatch() {
+        long[] origins = {0x8029fffffffffffL, 0x81283ffffffffffL, 0x8029fffffffffffL, 0x81283ffffffffffL};
+        long[] destinations = {0x8029fffffffffffL, 0x811d7ffffffffffL, 0x8079fffffffffffL, 0x8029fffffffffffL};
+
+        assertArrayEquals(new int[] {0, 2, -1, -1}, h3.h3Distance(origins, destinations));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testH3DistanceBatchLengths() {
+        h3.h3Distance(new long[2], new long[1]);
+    }
+
     @Test
     public void testH3Distance() throws DistanceUndefinedException {
         // Resolution 0 to some neighbors
@@ -401,4 +424,264 @@ public class TestTraversal extends BaseTestH3Core {
 
         h3.h3Line(origin, destination);
     }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testPolylineToCellsAntipodal() {
+        h3.polylineToCells(new double[] {10, 20, -10, -160}, 5);
+    }
+
+    @Test
+    public void testTrajectoryToCells() throws DistanceUndefinedException {
+        double[] latLngs = {
+                37.775, -122.418, 37.775, -122.418, 37.775, -122.418, 37.79, -122.39, 37.79, -122.39,
+                37.5, -122
+        };
+        long[] times = {0, 10, 20, 100, 110, 0};
+        long start = h3.geoToH3(37.775, -122.418, 9);
+        long end = h3.geoToH3(37.79, -122.39, 9);
+        int distance = h3.h3Distance(start, end);
+        assertTrue(distance > 1);
+
+        CellRuns runs = h3.trajectoryToCells(latLngs, times, new int[] {0, 5, 6}, 9);
+        assertEquals(2, runs.numTrajectories());
+        assertArrayEquals(new int[] {0, distance + 1, distance + 2}, runs.offsets);
+        assertEquals(start, runs.cells[0]);
+        assertEquals(3, runs.counts[0]);
+        assertEquals(0, runs.entryTimes[0]);
+        for (int i = 1; i < distance; i++) {
+            assertTrue("Gap is contiguous", h3.h3IndexesAreNeighbors(runs.cells[i - 1], runs.cells[i]));
+            assertEquals(0, runs.counts[i]);
+            assertTrue(runs.entryTimes[i] > 20 && runs.entryTimes[i] < 100);
+            assertTrue(runs.entryTimes[i] >= runs.entryTimes[i - 1]);
+        }
+        assertEquals(end, runs.cells[distance]);
+        assertEquals(2, runs.counts[distance]);
+        assertEquals(100, runs.entryTimes[distance]);
+        assertEquals(h3.geoToH3(37.5, -122, 9), runs.cells[distance + 1]);
+        assertEquals(1, runs.counts[distance + 1]);
+
+        assertEquals(new CellRuns(Arrays.copyOf(runs.cells, distance + 1), Arrays.copyOf(runs.counts, distance + 1),
+                        Arrays.copyOf(runs.entryTimes, distance + 1), new int[] {0, distance + 1}),
+                h3.trajectoryToCells(Arrays.copyOf(latLngs, 10), Arrays.copyOf(times, 5), 9));
+
+        double[] path = h3.cellRunsToPath(runs);
+        assertEquals(runs.numRuns() * 2, path.length);
+        GeoCoord center = h3.h3ToGeo(start);
+        assertEquals(center.lat, path[0], EPSILON);
+        assertEquals(center.lng, path[1], EPSILON);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testTrajectoryToCellsMismatchedTimes() {
+        h3.trajectoryToCells(new double[] {37.775, -122.418}, new long[] {0, 1}, 9);
+    }
+
+    @Test
+    public void testPolylineToCells() {
+        double[] line = {37.775, -122.418, 37.79, -122.39, 37.81, -122.41};
+        for (int res = 5; res < 10; res++) {
+            long[] cells = h3.polylineToCells(line, res);
+
+            assertEquals("Starts at the first point", h3.geoToH3(37.775, -122.418, res), cells[0]);
+            assertTrue("Ends at the last point",
+                    Arrays.stream(cells).anyMatch(c -> c == h3.geoToH3(37.81, -122.41, res)));
+            assertEquals("No duplicates", cells.length, Arrays.stream(cells).distinct().count());
+            for (int i = 1; i < cells.length; i++) {
+                assertTrue("Every index is a neighbor of the previous",
+                        h3.h3IndexesAreNeighbors(cells[i - 1], cells[i]));
+            }
+        }
+    }
+
+    @Test
+    public void testPolylineToCellsCoversSamples() {
+        double[] line = {37.775, -122.418, 37.79, -122.39};
+        int res = 9;
+        Set<Long> cells = Arrays.stream(h3.polylineToCells(line, res)).boxed().collect(Collectors.toSet());
+
+        // Points along a segment this short are very close to the great circle arc
+        for (int i = 0; i <= 1000; i++) {
+            double t = i / 1000.0;
+            long cell = h3.geoToH3(line[0] + (line[2] - line[0]) * t, line[1] + (line[3] - line[1]) * t, res);
+            assertTrue("Sample " + i + " is covered", cells.contains(cell));
+        }
+    }
+
+    @Test
+    public void testPolylineToCellsBuffer() {
+        double[] line = {37.775, -122.418, 37.79, -122.39};
+        long[] path = h3.polylineToCells(line, 9);
+        long[] buffered = h3.polylineToCells(line, 9, 0, 1);
+
+        assertArrayEquals("Path comes first", path, Arrays.copyOf(buffered, path.length));
+        Set<Long> expected = new HashSet<>();
+        for (long cell : path) {
+            expected.addAll(h3.kRing(cell, 1));
+        }
+        assertEquals(expected, Arrays.stream(buffered).boxed().collect(Collectors.toSet()));
+    }
+
+    @Test
+    public void testPolylineToCellsDensified() {
+        // Along a parallel, the great circle arc bows toward the pole
+        double[] line = {60, -10, 60, 10};
+        long[] cells = h3.polylineToCells(line, 5, 1000, 0);
+
+        for (int i = 0; i <= 100; i++) {
+            long cell = h3.geoToH3(60, -10 + 20 * i / 100.0, 5);
+            assertTrue("Point on the parallel is covered",
+                    Arrays.stream(cells).anyMatch(c -> c == cell));
+        }
+    }
+
+    @Test
+    public void testPolylineToCellsBatch() {
+        double[] lines = {37.775, -122.418, 37.79, -122.39, 37.81, -122.41, 40.7, -74, 40.75, -73.95};
+        int[] lineOffsets = {0, 3, 3, 5};
+        GroupedCells batch = h3.polylineToCellsBatch(lines, lineOffsets, 9, 0, 1, 2);
+
+        assertEquals(3, batch.numGroups());
+        assertArrayEquals(h3.polylineToCells(Arrays.copyOfRange(lines, 0, 6), 9, 0, 1), batch.group(0));
+        assertEquals("Empty polyline has no cells", 0, batch.groupSize(1));
+        assertArrayEquals(h3.polylineToCells(Arrays.copyOfRange(lines, 6, 10), 9, 0, 1), batch.group(2));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testPolylineToCellsBatchInvalidOffsets() {
+        h3.polylineToCellsBatch(new double[] {0, 0, 1, 1}, new int[] {0, 3}, 9, 0, 0);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testPolylineToCellsNaN() {
+        h3.polylineToCells(new double[] {0, 0, Double.NaN, 1, 1, 1}, 9);
+    }
+
+    @Test
+    public void testDilateErodeCells() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long[] disk = toSortedArray(h3.kRing(center, 5));
+
+        assertArrayEquals(toSortedArray(h3.kRing(center, 8)), h3.dilateCells(disk, 3));
+        assertArrayEquals(toSortedArray(h3.kRing(center, 2)), h3.erodeCells(disk, 3));
+        assertArrayEquals(disk, h3.dilateCells(disk, 0));
+        assertArrayEquals(disk, h3.erodeCells(disk, 0));
+        assertEquals("Eroded away entirely", 0, h3.erodeCells(disk, 6).length);
+        assertEquals(0, h3.dilateCells(new long[0], 2).length);
+    }
+
+    @Test
+    public void testDilateCellsMatchesKRing() {
+        long[] cells = {
+                h3.geoToH3(37.775, -122.418, 9),
+                h3.geoToH3(37.78, -122.41, 9),
+                h3.geoToH3(37.8, -122.45, 9)
+        };
+        Set<Long> expected = new HashSet<>();
+        for (long cell : cells) {
+            expected.addAll(h3.kRing(cell, 4));
+        }
+
+        assertArrayEquals(toSortedArray(expected), h3.dilateCells(cells, 4));
+    }
+
+    @Test
+    public void testOpenCloseCells() throws LineUndefinedException {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        Set<Long> ringWithHole = new HashSet<>(h3.kRing(center, 5));
+        ringWithHole.remove(center);
+        long[] disk = toSortedArray(h3.kRing(center, 5));
+
+        assertArrayEquals("Hole is filled", disk, h3.closeCells(toSortedArray(ringWithHole), 1));
+
+        // A line sticking out of the disk is narrower than the opening
+        Set<Long> withSpur = new HashSet<>(h3.kRing(center, 5));
+        List<Long> spur = h3.h3Line(center, h3.geoToH3(37.82, -122.418, 9));
+        withSpur.addAll(spur);
+        assertArrayEquals(disk, h3.openCells(toSortedArray(withSpur), 1));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testDilateCellsMixedResolutions() {
+        h3.dilateCells(new long[] {h3.geoToH3(0, 0, 5), h3.geoToH3(0, 0, 6)}, 1);
+    }
+
+    @Test
+    public void testDilateCellsInvalid() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        // Same resolution, but base cell 127 does not exist
+        long invalid = center | (0x7fL << 45);
+
+        assertArrayEquals(toSortedArray(h3.kRing(center, 1)), h3.dilateCells(new long[] {center, invalid}, 1));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testErodeCellsNegative() {
+        h3.erodeCells(new long[] {h3.geoToH3(0, 0, 5)}, -1);
+    }
+
+    @Test
+    public void testConnectedComponents() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long other = h3.geoToH3(37.5, -122, 9);
+        List<Long> disk = h3.kRing(center, 2);
+        Set<Long> cells = new HashSet<>(disk);
+        cells.add(other);
+
+        GroupedCells components = h3.connectedComponents(toSortedArray(cells));
+        assertEquals(2, components.numGroups());
+        Set<Long> first = new HashSet<>();
+        for (long cell : components.group(0)) {
+            first.add(cell);
+        }
+        Set<Long> second = new HashSet<>();
+        for (long cell : components.group(1)) {
+            second.add(cell);
+        }
+        assertTrue(first.equals(new HashSet<>(disk)) && second.equals(Collections.singleton(other))
+                || second.equals(new HashSet<>(disk)) && first.equals(Collections.singleton(other)));
+
+        assertArrayEquals(toSortedArray(disk), h3.removeSmallComponents(toSortedArray(cells), 2));
+        assertArrayEquals(toSortedArray(cells), h3.removeSmallComponents(toSortedArray(cells), 0));
+        assertEquals(0, h3.connectedComponents(new long[0]).numGroups());
+    }
+
+    @Test
+    public void testConnectedComponentsInvalid() {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long[] disk = toSortedArray(h3.kRing(center, 1));
+        long[] cells = Arrays.copyOf(disk, disk.length + 1);
+        // Same resolution, but base cell 127 does not exist
+        cells[disk.length] = center | (0x7fL << 45);
+
+        assertEquals(1, h3.connectedComponents(cells).numGroups());
+        assertArrayEquals(disk, h3.fillHoles(cells, 1));
+    }
+
+    @Test
+    public void testFillHoles() throws PentagonEncounteredException {
+        long center = h3.geoToH3(37.775, -122.418, 9);
+        long[] disk = toSortedArray(h3.kRing(center, 6));
+        Set<Long> withHoles = new HashSet<>(h3.kRing(center, 6));
+        withHoles.remove(center);
+        // A larger hole of 7 cells
+        long other = h3.hexRing(center, 3).get(0);
+        withHoles.removeAll(h3.kRing(other, 1));
+        long[] cells = toSortedArray(withHoles);
+
+        assertArrayEquals(cells, h3.fillHoles(cells, 0));
+        long[] smallFilled = h3.fillHoles(cells, 6);
+        assertEquals(cells.length + 1, smallFilled.length);
+        assertTrue(Arrays.binarySearch(smallFilled, center) >= 0);
+        assertArrayEquals(disk, h3.fillHoles(cells, 7));
+        assertArrayEquals("Outside is not a hole", disk, h3.fillHoles(disk, 1000));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testFillHolesNegative() {
+        h3.fillHoles(new long[] {h3.geoToH3(0, 0, 5)}, -1);
+    }
+
+    private static long[] toSortedArray(Collection<Long> cells) {
+        return cells.stream().mapToLong(Long::longValue).sorted().toArray();
+    }
 }
@@ -15,13 +15,20 @@
  */
 package com.uber.h3core;
 
+import com.uber.h3core.exceptions.PentagonEncounteredException;
 import com.uber.h3core.util.GeoCoord;
+import com.uber.h3core.util.RegionBoundary;
 import org.junit.Test;
 
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collection;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
+import java.util.stream.Collectors;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNotEquals;
@@ -67,4 +74,52 @@ public class TestUnidirectionalEdges extends BaseTestH3Core {
     public void testUnidirectionalEdgesNotNeighbors() {
         h3.getH3UnidirectionalEdge("891ea6d6533ffff", "891ea6992dbffff");
     }
-}
\ No newline at end of file
+
+    @Test
+    public void testBoundaryEdges() throws PentagonEncounteredException {
+        long center = h3.stringToH3("891ea6d6533ffff");
+        long[] disk = h3.kRing(center, 2).stream().mapToLong(Long::longValue).toArray();
+        Set<Long> diskSet = Arrays.stream(disk).boxed().collect(Collectors.toSet());
+
+        RegionBoundary boundary = h3.boundaryEdges(disk);
+
+        assertEquals(new HashSet<>(h3.hexRing(center, 2)), toSet(boundary.boundaryCells));
+        assertEquals(new HashSet<>(h3.hexRing(center, 3)), toSet(boundary.exteriorCells));
+        // Six corners with three edges out, and six sides with two
+        assertEquals(6 * 3 + 6 * 2, boundary.edges.length);
+        for (long edge : boundary.edges) {
+            List<Long> originDestination = h3.getH3IndexesFromUnidirectionalEdge(edge);
+            assertTrue(diskSet.contains(originDestination.get(0)));
+            assertFalse(diskSet.contains(originDestination.get(1)));
+        }
+    }
+
+    @Test
+    public void testBoundaryEdgesEmpty() {
+        RegionBoundary boundary = h3.boundaryEdges(new long[0]);
+        assertEquals(0, boundary.edges.length);
+        assertEquals(0, boundary.boundaryCells.length);
+        assertEquals(0, boundary.exteriorCells.length);
+    }
+
+    @Test
+    public void testBoundaryEdgesInvalid() {
+        long center = h3.stringToH3("891ea6d6533ffff");
+        // Same resolution, but base cell 127 does not exist
+        long invalid = center | (0x7fL << 45);
+
+        RegionBoundary boundary = h3.boundaryEdges(new long[] {center, invalid});
+
+        assertArrayEquals(new long[] {center}, boundary.boundaryCells);
+        assertEquals(6, boundary.edges.length);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testBoundaryEdgesMixedResolutions() {
+        h3.boundaryEdges(new long[] {h3.geoToH3(0, 0, 5), h3.geoToH3(0, 0, 6)});
+    }
+
+    private static Set<Long> toSet(long[] cells) {
+        return Arrays.stream(cells).boxed().collect(Collectors.toSet());
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2021 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.uber.h3core.benchmarking;
+
+import com.uber.h3core.H3Core;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+import java.io.IOException;
+import java.util.Random;
+
+/**
+ * Benchmarks <code>geoToH3Approx</code> against the exact batch <code>geoToH3</code>.
+ *
+ * <p>Running <code>main</code> also prints the rate at which the two disagree.
+ */
+public class GeoToH3ApproxBenchmark {
+    @Benchmark
+    @BenchmarkMode(Mode.Throughput)
+    public long[] benchmarkGeoToH3Batch() {
+        return BenchmarkState.h3Core.geoToH3(BenchmarkState.latLngs, BenchmarkState.RES);
+    }
+
+    @Benchmark
+    @BenchmarkMode(Mode.Throughput)
+    public long[] benchmarkGeoToH3Approx() {
+        return BenchmarkState.h3Core.geoToH3Approx(BenchmarkState.latLngs, BenchmarkState.RES);
+    }
+
+    @State(Scope.Benchmark)
+    public static class BenchmarkState {
+        static final int RES = 9;
+        static H3Core h3Core;
+        /**
+         * Points spread around San Francisco, approximately like vehicle positions.
+         */
+        static double[] latLngs;
+
+        static {
+            try {
+                h3Core = H3Core.newInstance();
+            } catch (IOException ioe) {
+                throw new RuntimeException(ioe);
+            }
+
+            Random random = new Random(0);
+            latLngs = new double[200000];
+            for (int i = 0; i < latLngs.length; i += 2) {
+                latLngs[i] = 37.775 + random.nextGaussian() * 0.05;
+                latLngs[i + 1] = -122.418 + random.nextGaussian() * 0.05;
+            }
+        }
+    }
+
+    public static void main(String[] args) throws RunnerException {
+        for (int res = 0; res <= 15; res++) {
+            long[] exact = BenchmarkState.h3Core.geoToH3(BenchmarkState.latLngs, res);
+            long[] approx = BenchmarkState.h3Core.geoToH3Approx(BenchmarkState.latLngs, res);
+            int mismatches = 0;
+            for (int i = 0; i < exact.length; i++) {
+                if (exact[i] != approx[i]) {
+                    mismatches++;
+                }
+            }
+            System.out.printf("res %d: %d of %d points differ (rate %g)%n",
+                    res, mismatches, exact.length, (double) mismatches / exact.length);
+        }
+
+        Options opt = new OptionsBuilder()
+                .include(GeoToH3ApproxBenchmark.class.getSimpleName())
+                .forks(1)
+                .build();
+
+        new Runner(opt).run();
+    }
+}
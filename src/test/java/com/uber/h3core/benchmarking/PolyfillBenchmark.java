@@ -18,6 +18,7 @@ package com.uber.h3core.benchmarking;
 import com.google.common.collect.ImmutableList;
 import com.uber.h3core.H3Core;
 import com.uber.h3core.util.GeoCoord;
+import com.uber.h3core.util.GroupedCells;
 import org.openjdk.jmh.annotations.Benchmark;
 import org.openjdk.jmh.annotations.BenchmarkMode;
 import org.openjdk.jmh.annotations.Mode;
@@ -29,6 +30,7 @@ import org.openjdk.jmh.runner.options.Options;
 import org.openjdk.jmh.runner.options.OptionsBuilder;
 
 import java.io.IOException;
+import java.util.ArrayList;
 import java.util.List;
 
 /**
@@ -101,9 +103,44 @@ public class PolyfillBenchmark {
         );
     }
 
+    @Benchmark
+    @BenchmarkMode(Mode.Throughput)
+    public List<Long> benchmarkPolyfillManyVertices() {
+        return BenchmarkState.h3Core.polyfill(BenchmarkState.manyVertices, null, 9);
+    }
+
+    @Benchmark
+    @BenchmarkMode(Mode.Throughput)
+    public int benchmarkPolyfillSmallPolygons() {
+        int total = 0;
+        for (List<GeoCoord> footprint : BenchmarkState.footprints) {
+            total += BenchmarkState.h3Core.polyfill(footprint, null, 12).size();
+        }
+        return total;
+    }
+
+    @Benchmark
+    @BenchmarkMode(Mode.Throughput)
+    public GroupedCells benchmarkPolyfillBatchSmallPolygons() {
+        return BenchmarkState.h3Core.polyfillBatch(BenchmarkState.footprintVerts, BenchmarkState.footprintRingOffsets,
+                BenchmarkState.footprintPolygonOffsets, 12);
+    }
+
     @State(Scope.Benchmark)
     public static class BenchmarkState {
         static H3Core h3Core;
+        /**
+         * A polygon around San Francisco with a detailed, coastline-like outline.
+         */
+        static List<GeoCoord> manyVertices;
+        /**
+         * Small squares, approximately the size of buildings, as lists and in compressed sparse
+         * row form.
+         */
+        static List<List<GeoCoord>> footprints;
+        static double[] footprintVerts;
+        static int[] footprintRingOffsets;
+        static int[] footprintPolygonOffsets;
 
         static {
             try {
@@ -111,6 +148,36 @@ public class PolyfillBenchmark {
             } catch (IOException ioe) {
                 throw new RuntimeException(ioe);
             }
+
+            manyVertices = new ArrayList<>();
+            int numVerts = 100000;
+            for (int i = 0; i < numVerts; i++) {
+                double angle = 2 * Math.PI * i / numVerts;
+                double radius = 0.05 * (1 + 0.1 * Math.sin(angle * 500) + 0.02 * Math.sin(angle * 7919));
+                manyVertices.add(new GeoCoord(37.76 + radius * Math.sin(angle), -122.44 + radius * Math.cos(angle)));
+            }
+
+            int numFootprints = 10000;
+            footprints = new ArrayList<>(numFootprints);
+            footprintVerts = new double[numFootprints * 8];
+            footprintRingOffsets = new int[numFootprints + 1];
+            footprintPolygonOffsets = new int[numFootprints + 1];
+            for (int i = 0; i < numFootprints; i++) {
+                double lat = 37.7 + (i / 100) * 0.001;
+                double lng = -122.5 + (i % 100) * 0.001;
+                List<GeoCoord> footprint = ImmutableList.of(
+                        new GeoCoord(lat, lng), new GeoCoord(lat, lng + 0.0004),
+                        new GeoCoord(lat + 0.0003, lng + 0.0004), new GeoCoord(lat + 0.0003, lng));
+                footprints.add(footprint);
+                for (int j = 0; j < 4; j++) {
+                    footprintVerts[i * 8 + j * 2] = footprint.get(j).lat;
+                    footprintVerts[i * 8 + j * 2 + 1] = footprint.get(j).lng;
+                }
+                footprintRingOffsets[i] = i * 4;
+                footprintPolygonOffsets[i] = i;
+            }
+            footprintRingOffsets[numFootprints] = numFootprints * 4;
+            footprintPolygonOffsets[numFootprints] = numFootprints;
         }
     }
 